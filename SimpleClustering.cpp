@@ -13,26 +13,501 @@
 #include "SimpleClustering.h"
 
 #include <list>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <functional>
 
 #include <cmath>
+#include <cstdio>
 
 namespace NS_Clustering
 {
-    double  Dot_Radius        = 10.0;
-    double  Cluster_1_Radius  = 50.0;
-    double  Cluster_2_Radius  = 300.0;
-    double  Cluster_3_Radius  = 1500.0;
-    double  Cluster_4_Radius  = 10000.0;
+    // Minimum number of elements per thread for which parallel sorting makes sense
+    static const std::size_t Min_Parallel_Sort_Size = 65536;
 
-    double   AdditionalRadiusValue      = 3.0;
+    // Web Mercator: radius of the sphere (meters) and the latitude of the edges of the square map (degrees)
+    static const double  Pi                    = 3.14159265358979323846;
+    static const double  Web_Mercator_Radius   = 6378137.0;
+    static const double  Web_Mercator_Max_Lat  = 85.051128779806592;
+
+    TCoord  Dot_Radius        = 10.0;
+    TCoord  Cluster_1_Radius  = 50.0;
+    TCoord  Cluster_2_Radius  = 300.0;
+    TCoord  Cluster_3_Radius  = 1500.0;
+    TCoord  Cluster_4_Radius  = 10000.0;
+
+    TCoord   AdditionalRadiusValue      = 3.0;
     int16_t  Use_AdditionalRadiusValue  = 1;
 
     // Check if the coordinate is in a circle
-    bool Coord_In_Circle(const double C_X, const double C_Y, const double C_Radius, const double X, const double Y) noexcept
+    bool Coord_In_Circle(const TCoord C_X, const TCoord C_Y, const TCoord C_Radius, const TCoord X, const TCoord Y) noexcept
+    {
+        SIMPLE_CLUSTERING_COUNT(Coord_In_Circle_Count);
+
+        #if defined(SIMPLE_CLUSTERING_INT_COORD)
+          /* Exact check in integers. The radius with the additional value is below 2^32, so its square fits in uint64_t, and
+          differences beyond the radius are rejected first, so dy * dy does not exceed it and the sum is not formed. */
+          const int64_t  r   = static_cast<int64_t>(C_Radius) + (Use_AdditionalRadiusValue ? AdditionalRadiusValue : 0);
+          const int64_t  dx  = static_cast<int64_t>(C_X) - X;
+          const int64_t  dy  = static_cast<int64_t>(C_Y) - Y;
+
+          if (r < 0 || std::llabs(dx) > r || std::llabs(dy) > r)
+              return false;
+
+          const uint64_t  ux  = static_cast<uint64_t>(std::llabs(dx));
+          const uint64_t  uy  = static_cast<uint64_t>(std::llabs(dy));
+          const uint64_t  ur  = static_cast<uint64_t>(r);
+
+          return ux * ux <= ur * ur - uy * uy;
+        #else
+          return std::sqrt((C_X - X) * (C_X - X) + (C_Y - Y) * (C_Y - Y)) <= C_Radius + (Use_AdditionalRadiusValue ? AdditionalRadiusValue : 0);
+        #endif
+    }
+
+    // Set the cluster that contains all clustering elements of the set
+    template <typename Type> void Set_Parent(const std::map<TCoordKey, const Type*>& MapClusteringElem, const TClusteringElem* const Parent) noexcept
+    {
+        for (const auto& ce : MapClusteringElem)
+            ce.second->Parent = Parent;
+    }
+
+    // Add the amount of data and the number of dots of the clustering element to the counters of the cluster
+    void Add_ClusteringElem_Counts(const TClusteringElem* const ClusteringElem, std::size_t& DataCount, std::size_t& DotCount) noexcept
+    {
+        switch (ClusteringElem->Get_ClusteringElem_Id())
+        {
+            case ID_DOT:       { DataCount += static_cast<const TDot*>(ClusteringElem)->Get_Count(); DotCount += 1; break; }
+            case ID_CLUSTER_1: { DataCount += static_cast<const TCluster_1*>(ClusteringElem)->DataCount; DotCount += static_cast<const TCluster_1*>(ClusteringElem)->DotCount; break; }
+            case ID_CLUSTER_2: { DataCount += static_cast<const TCluster_2*>(ClusteringElem)->DataCount; DotCount += static_cast<const TCluster_2*>(ClusteringElem)->DotCount; break; }
+            case ID_CLUSTER_3: { DataCount += static_cast<const TCluster_3*>(ClusteringElem)->DataCount; DotCount += static_cast<const TCluster_3*>(ClusteringElem)->DotCount; break; }
+            default: break;
+        }
+    }
+
+    /* Add the created cluster to the set. If its center coincides with the center of a cluster already in the set, that cluster
+    absorbs it instead of losing one of them, and the result is added again with the new center. */
+    template <typename Type> void Emplace_Cluster(std::map<TCoordKey, Type*>& MapCluster, Type* Cluster, void (Type::*Eat_Cluster)(Type*&))
+    {
+        auto result = MapCluster.emplace(TCoordKey(Cluster->X, Cluster->Y), Cluster);
+
+        while (!result.second) // center is already occupied
+        {
+            Type* const existing = result.first->second;
+
+            MapCluster.erase(result.first);     // the center of the existing cluster will change
+            (existing->*Eat_Cluster)(Cluster);  // absorb the added cluster
+
+            Cluster  = existing;
+            result   = MapCluster.emplace(TCoordKey(Cluster->X, Cluster->Y), Cluster);
+        }
+    }
+
+    // Get the number of threads for processing of the array (0 - by the number of hardware threads), each thread gets at least Min_Parallel_Sort_Size elements
+    uint32_t Get_Thread_Count(uint32_t ThreadCount, const std::size_t ArrSize) noexcept
+    {
+        if (ThreadCount == 0)
+            ThreadCount = std::max(1U, std::thread::hardware_concurrency());
+
+        return static_cast<uint32_t>(std::min<std::size_t>(ThreadCount, ArrSize / Min_Parallel_Sort_Size));
+    }
+
+    // Sort array in several threads: each thread sorts its part, then the parts are merged in pairs
+    template <typename Type, typename Compare> void Parallel_Sort(std::vector<Type>& Arr, const Compare& Comp, uint32_t ThreadCount)
+    {
+        ThreadCount = Get_Thread_Count(ThreadCount, Arr.size());
+
+        if (ThreadCount < 2) // not worth parallelizing
+        {
+            std::sort(Arr.begin(), Arr.end(), Comp);
+
+            return;
+        }
+
+        std::vector<std::size_t>  bounds;   // borders of the parts of the array
+        std::vector<std::thread>  threads;  // working threads
+
+        for (uint32_t i = 0; i <= ThreadCount; ++i)
+            bounds.push_back(Arr.size() * i / ThreadCount);
+
+        TTrace* const trace = Current_Trace; // working threads record their events in the trace of this thread
+
+        // Sort parts
+        for (uint32_t i = 0; i < ThreadCount; ++i)
+        {
+            threads.emplace_back([&Arr, &bounds, &Comp, trace, i]()
+            {
+                TTraceScope trace_scope(trace, "Sort_Part");
+
+                std::sort(Arr.begin() + bounds[i], Arr.begin() + bounds[i + 1], Comp);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        // Merge neighboring parts, doubling their size on every step
+        for (uint32_t step = 1; step < ThreadCount; step *= 2)
+        {
+            threads.clear();
+
+            for (uint32_t i = 0; i + step < ThreadCount; i += 2 * step)
+            {
+                const std::size_t  first   = bounds[i];
+                const std::size_t  middle  = bounds[i + step];
+                const std::size_t  last    = bounds[std::min(i + 2 * step, ThreadCount)];
+
+                threads.emplace_back([&Arr, &Comp, trace, first, middle, last]()
+                {
+                    TTraceScope trace_scope(trace, "Merge_Parts");
+
+                    std::inplace_merge(Arr.begin() + first, Arr.begin() + middle, Arr.begin() + last, Comp);
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+    }
+
+    /* Collect indexes of the array elements with finite coordinates in several threads, each thread checks its part. NaN and
+    infinite coordinates break the order of coordinate keys, so such elements are skipped. */
+    void Collect_Finite_Coords(const uint32_t ArrSize, const double* const X_Arr, const double* const Y_Arr, uint32_t ThreadCount, std::vector<uint32_t>& Order)
+    {
+        ThreadCount = std::max(1U, Get_Thread_Count(ThreadCount, ArrSize));
+
+        std::vector<std::vector<uint32_t>>  parts(ThreadCount);  // indexes found by each thread
+        std::vector<std::thread>            threads;             // working threads
+
+        TTrace* const trace = Current_Trace; // working threads record their events in the trace of this thread
+
+        const auto collect = [ArrSize, X_Arr, Y_Arr, ThreadCount, trace, &parts](const uint32_t Part)
+        {
+            TTraceScope trace_scope(trace, "Collect_Finite_Coords_Part");
+
+            const uint32_t  first  = static_cast<uint32_t>(static_cast<uint64_t>(ArrSize) * Part / ThreadCount);
+            const uint32_t  last   = static_cast<uint32_t>(static_cast<uint64_t>(ArrSize) * (Part + 1) / ThreadCount);
+
+            parts[Part].reserve(last - first);
+
+            for (uint32_t i = first; i < last; ++i)
+            {
+                if (Coord_Is_Valid(X_Arr[i]) && Coord_Is_Valid(Y_Arr[i]))
+                    parts[Part].push_back(i);
+            }
+        };
+
+        for (uint32_t i = 1; i < ThreadCount; ++i)
+            threads.emplace_back(collect, i);
+
+        collect(0); // first part in the current thread
+
+        for (auto& thread : threads)
+            thread.join();
+
+        Order.swap(parts[0]);
+
+        for (uint32_t i = 1; i < ThreadCount; ++i)
+            Order.insert(Order.end(), parts[i].cbegin(), parts[i].cend());
+    }
+
+    // Process the array in several threads, Process(First, Last) is called for the part of each thread
+    template <typename Process> void Process_Parts(const uint32_t ArrSize, uint32_t ThreadCount, const char* const Name, const Process& Func)
+    {
+        ThreadCount = std::max(1U, Get_Thread_Count(ThreadCount, ArrSize));
+
+        std::vector<std::thread> threads; // working threads
+
+        TTrace* const trace = Current_Trace; // working threads record their events in the trace of this thread
+
+        const auto process = [ArrSize, ThreadCount, Name, trace, &Func](const uint32_t Part)
+        {
+            TTraceScope trace_scope(trace, Name);
+
+            Func(static_cast<uint32_t>(static_cast<uint64_t>(ArrSize) * Part / ThreadCount),
+                static_cast<uint32_t>(static_cast<uint64_t>(ArrSize) * (Part + 1) / ThreadCount));
+        };
+
+        for (uint32_t i = 1; i < ThreadCount; ++i)
+            threads.emplace_back(process, i);
+
+        process(0); // first part in the current thread
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    struct TGridCell // cell of the grid of approximate clustering
+    {
+        int64_t  X;
+        int64_t  Y;
+
+        bool operator == (const TGridCell& Obj) const noexcept
+        {
+            return X == Obj.X && Y == Obj.Y;
+        }
+    };
+
+    struct TGridCellHash // hash of the cell of the grid
+    {
+        std::size_t operator () (const TGridCell& Cell) const noexcept
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(Cell.X) * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(Cell.Y));
+        }
+    };
+
+    // Get the number of the cell of the grid that contains the coordinate
+    int64_t Get_Grid_Cell(const TCoord Coord, const double Cell_Size) noexcept
+    {
+        const double cell = std::floor(Coord / Cell_Size);
+
+        return static_cast<int64_t>(std::max(-4.0e18, std::min(cell, 4.0e18))); // very far coordinates share the outermost cells
+    }
+
+    /* Create set of clusters by the grid with cells of the size of the radius of clusters: elements are binned into cells in one
+    pass and the elements of each cell become one cluster, then the clusters of neighboring cells are merged once, if needed */
+    template <typename Type, typename Elem> void Create_Grid_Clusters(
+        const std::vector<Elem*>&    VecElem,
+        std::map<TCoordKey, Type*>&  MapCluster,
+        const TCoord                 Radius,
+        const bool                   SingleElem_To_Cluster,
+        const bool                   Merge_Neighbors,
+        void (Type::*Add_Elem)(Elem* const, const bool),
+        bool (Type::*Check_Cluster)(const Type* const) const,
+        void (Type::*Eat_Cluster)(Type*&))
+    {
+        struct TCell // elements of the cell
+        {
+            Elem*  First;    // first element of the cell
+            Type*  Cluster;  // cluster of the cell (nullptr - the cell has a single element or its cluster is absorbed)
+            bool   Merged;   // the cluster has absorbed the cluster of a neighboring cell or was absorbed
+        };
+
+        std::unordered_map<TGridCell, TCell, TGridCellHash>  map_cell;                                                       // cells with elements
+        const double                                         cell_size = Radius > 0 ? static_cast<double>(Radius) : 1.0;  // radius can be rounded to 0 for integer coordinates
+
+        map_cell.reserve(VecElem.size());
+
+        SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+        TTraceScope trace_bin("Bin_Elements");
+
+        for (const auto elem : VecElem) // elements of the cell are added to its cluster, the center is calculated once after all
+        {
+            const auto  result  = map_cell.emplace(TGridCell{Get_Grid_Cell(elem->X, cell_size), Get_Grid_Cell(elem->Y, cell_size)}, TCell{elem, nullptr, false});
+            TCell&      cell    = result.first->second;
+
+            if (!result.second) // the cell already has elements
+            {
+                if (!cell.Cluster) // second element of the cell
+                {
+                    cell.Cluster = new Type();
+                    (cell.Cluster->*Add_Elem)(cell.First, false);
+                }
+
+                (cell.Cluster->*Add_Elem)(elem, false);
+            }
+        }
+
+        for (auto& cell : map_cell)
+        {
+            if (cell.second.Cluster)
+                cell.second.Cluster->Set_Center();
+            else if (SingleElem_To_Cluster) // single element of the cell becomes a cluster
+            {
+                cell.second.Cluster = new Type();
+                (cell.second.Cluster->*Add_Elem)(cell.second.First, true);
+            }
+        }
+
+        trace_bin.Stop();
+
+        if (Merge_Neighbors) // each cluster takes part in one merge at most, so it covers at most two neighboring cells
+        {
+            SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+            TTraceScope trace_merge("Merge_Neighbors");
+
+            static const int64_t offsets[4][2] = {{1, -1}, {1, 0}, {1, 1}, {0, 1}}; // the other neighbors check the cell themselves
+
+            for (auto& cell : map_cell)
+            {
+                if (!cell.second.Cluster || cell.second.Merged)
+                    continue;
+
+                for (const auto& offset : offsets)
+                {
+                    const auto it = map_cell.find(TGridCell{cell.first.X + offset[0], cell.first.Y + offset[1]});
+
+                    if (it != map_cell.end() && it->second.Cluster && !it->second.Merged && (it->second.Cluster->*Check_Cluster)(cell.second.Cluster))
+                    {
+                        (it->second.Cluster->*Eat_Cluster)(cell.second.Cluster); // the cluster of the cell is absorbed and set to nullptr
+                        it->second.Merged = true;
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        TTraceScope trace_collect("Collect_Clusters");
+
+        Clear_Map_Of_ClusteringElem(MapCluster); // clear the set of clusters
+
+        for (const auto& cell : map_cell)
+        {
+            if (cell.second.Cluster)
+                Emplace_Cluster(MapCluster, cell.second.Cluster, Eat_Cluster);
+        }
+    }
+}
+
+#if defined(SIMPLE_CLUSTERING_STATS)
+/*** TStatsScope ************************************************************************************/
+thread_local NS_Clustering::TStats* NS_Clustering::Current_Stats = nullptr;
+
+NS_Clustering::TStatsScope::TStatsScope(TStats& Stats_) noexcept :
+    Previous(Current_Stats),
+    Stats   (Stats_),
+    Start   (static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()))
+{
+    Stats          = TStats();  // counters of the new phase
+    Current_Stats  = &Stats;    // count in this thread
+}
+
+NS_Clustering::TStatsScope::~TStatsScope(void) noexcept
+{
+    Stats.Nanoseconds  = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()) - Start;
+    Current_Stats      = Previous;
+}
+/****************************************************************************************************/
+#endif
+
+
+/*** TTrace *****************************************************************************************/
+thread_local NS_Clustering::TTrace* NS_Clustering::Current_Trace = nullptr;
+
+NS_Clustering::TTrace::TTrace(void) noexcept :
+    Created(std::chrono::steady_clock::now())
+{}
+
+// Get the time from the beginning of the timeline in nanoseconds
+uint64_t NS_Clustering::TTrace::Get_Time(void) const noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Created).count());
+}
+
+// Get the number of the thread, a new thread gets the next number (Mutex must be locked)
+uint32_t NS_Clustering::TTrace::Get_Thread_Number(const std::thread::id Id)
+{
+    const uint32_t thread = static_cast<uint32_t>(std::find(Threads.cbegin(), Threads.cend(), Id) - Threads.cbegin());
+
+    if (thread == Threads.size()) // new thread
+        Threads.push_back(Id);
+
+    return thread;
+}
+
+// Number the current thread if it has no number yet
+void NS_Clustering::TTrace::Add_Thread(void)
+{
+    const std::thread::id        id = std::this_thread::get_id();
+    std::lock_guard<std::mutex>  lock(Mutex);
+
+    Get_Thread_Number(id);
+}
+
+// Add the event of the current thread
+void NS_Clustering::TTrace::Add(const char* const Name, const uint64_t Start, const uint64_t End)
+{
+    const std::thread::id        id = std::this_thread::get_id();
+    std::lock_guard<std::mutex>  lock(Mutex);
+
+    Events.push_back({ Name, Get_Thread_Number(id), Start, End - Start });
+}
+
+// Write events to the JSON file
+bool NS_Clustering::TTrace::Write(const char* const FileName) const
+{
+    std::FILE* const file = std::fopen(FileName, "w");
+
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(Mutex);
+
+    std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+
+    for (std::size_t i = 0; i < Threads.size(); ++i) // names of threads
+    {
+        std::fprintf(file, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"%s %u\"}},\n",
+            static_cast<unsigned>(i), i == 0 ? "Clustering" : "Worker", static_cast<unsigned>(i));
+    }
+
+    // Complete events, times are in microseconds
+    for (std::size_t i = 0; i < Events.size(); ++i)
+    {
+        const TEvent& event = Events[i];
+
+        std::fprintf(file, "{\"name\": \"%s\", \"cat\": \"SimpleClustering\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}%s\n",
+            event.Name, static_cast<unsigned>(event.Thread), event.Start / 1000.0, event.Duration / 1000.0, i + 1 < Events.size() ? "," : "");
+    }
+
+    std::fprintf(file, "]}\n");
+
+    const bool result = !std::ferror(file);
+
+    return std::fclose(file) == 0 && result;
+}
+/****************************************************************************************************/
+
+
+/*** TTraceScope ************************************************************************************/
+NS_Clustering::TTraceScope::TTraceScope(const char* const Name_) noexcept :
+    Trace   (Current_Trace),
+    Previous(Current_Trace),
+    Attached(false),
+    Name    (Name_),
+    Start   (Trace ? Trace->Get_Time() : 0)
+{}
+
+NS_Clustering::TTraceScope::TTraceScope(TTrace* const Trace_, const char* const Name_) noexcept :
+    Trace   (Trace_),
+    Previous(Current_Trace),
+    Attached(true),
+    Name    (Name_),
+    Start   (Trace ? Trace->Get_Time() : 0)
+{
+    Current_Trace = Trace;
+
+    if (Trace)
+    {
+        try { Trace->Add_Thread(); } catch (...) {} // the thread is numbered by its first event if there is no memory
+    }
+}
+
+NS_Clustering::TTraceScope::~TTraceScope(void) noexcept
+{
+    Stop();
+
+    if (Attached)
+        Current_Trace = Previous;
+}
+
+// End the event before the end of the scope
+void NS_Clustering::TTraceScope::Stop(void) noexcept
+{
+    if (Trace)
     {
-        return std::sqrt((C_X - X) * (C_X - X) + (C_Y - Y) * (C_Y - Y)) <= C_Radius + (Use_AdditionalRadiusValue ? AdditionalRadiusValue : 0);
+        try { Trace->Add(Name, Start, Trace->Get_Time()); } catch (...) {} // the event is lost if there is no memory
+
+        Trace = nullptr;
     }
 }
+/****************************************************************************************************/
+
 
 /*** TCoordKey **************************************************************************************/
 NS_Clustering::TCoordKey::TCoordKey(void) noexcept :
@@ -41,24 +516,36 @@ NS_Clustering::TCoordKey::TCoordKey(void) noexcept :
 {}
 
 NS_Clustering::TCoordKey::TCoordKey(const double X_, const double Y_) noexcept :
-    X(X_),
-    Y(Y_)
+    X(To_Coord(X_)),
+    Y(To_Coord(Y_))
 {}
 
 bool NS_Clustering::TCoordKey::operator == (const TCoordKey& Obj) const noexcept
 {
-    return X == Obj.X && Y == Obj.Y;
+    #if defined(SIMPLE_CLUSTERING_INT_COORD)
+      return Get_Packed() == Obj.Get_Packed();
+    #else
+      return X == Obj.X && Y == Obj.Y;
+    #endif
 }
 
 bool NS_Clustering::TCoordKey::operator != (const TCoordKey& Obj) const noexcept
 {
-    return X != Obj.X || Y != Obj.Y;
+    #if defined(SIMPLE_CLUSTERING_INT_COORD)
+      return Get_Packed() != Obj.Get_Packed();
+    #else
+      return X != Obj.X || Y != Obj.Y;
+    #endif
 }
 
 bool NS_Clustering::TCoordKey::operator < (const TCoordKey& Obj) const noexcept
 {
-    return X < Obj.X ||
-        (X == Obj.X && Y < Obj.Y);
+    #if defined(SIMPLE_CLUSTERING_INT_COORD)
+      return Get_Packed() < Obj.Get_Packed(); // one comparison instead of two
+    #else
+      return X < Obj.X ||
+          (X == Obj.X && Y < Obj.Y);
+    #endif
 }
 /****************************************************************************************************/
 
@@ -70,8 +557,13 @@ NS_Clustering::TClusteringElem::TClusteringElem(void) noexcept :
     Y                (0.0),
     R                (0.0),
     InCluster        (false),
-    Tag              (0xFFFFFFFFFFFFFFFFULL)
-{}
+    Selected         (true),
+    Tag              (0xFFFFFFFFFFFFFFFFULL),
+    Parent           (nullptr),
+    Index            (INDEX_NONE)
+{
+    SIMPLE_CLUSTERING_COUNT(Allocation_Count);
+}
 
 NS_Clustering::TClusteringElem::TClusteringElem(const uint16_t ClusteringElem_Id_) noexcept :
     ClusteringElem_Id(ClusteringElem_Id_),
@@ -79,17 +571,27 @@ NS_Clustering::TClusteringElem::TClusteringElem(const uint16_t ClusteringElem_Id
     Y                (0.0),
     R                (0.0),
     InCluster        (false),
-    Tag              (0xFFFFFFFFFFFFFFFFULL)
-{}
+    Selected         (true),
+    Tag              (0xFFFFFFFFFFFFFFFFULL),
+    Parent           (nullptr),
+    Index            (INDEX_NONE)
+{
+    SIMPLE_CLUSTERING_COUNT(Allocation_Count);
+}
 
 NS_Clustering::TClusteringElem::TClusteringElem(const uint16_t ClusteringElem_Id_, const double X_, const double Y_, const double R_, const bool InCluster_, const uint64_t Tag_) noexcept :
     ClusteringElem_Id(ClusteringElem_Id_),
-    X                (X_),
-    Y                (Y_),
-    R                (R_),
+    X                (To_Coord(X_)),
+    Y                (To_Coord(Y_)),
+    R                (To_Coord(R_)),
     InCluster        (InCluster_),
-    Tag              (Tag_)
-{}
+    Selected         (true),
+    Tag              (Tag_),
+    Parent           (nullptr),
+    Index            (INDEX_NONE)
+{
+    SIMPLE_CLUSTERING_COUNT(Allocation_Count);
+}
 
 NS_Clustering::TClusteringElem::~TClusteringElem(void) noexcept {}
 
@@ -108,6 +610,272 @@ void NS_Clustering::TClusteringElem::Set_Tag_If_Empty(const uint64_t Tag_) noexc
 /****************************************************************************************************/
 
 
+/*** TDotDataArena **********************************************************************************/
+NS_Clustering::TDotDataArena::TDotDataArena(void) noexcept :
+    Size     (0),
+    Base_Size(0)
+{}
+
+// Allocate a contiguous block for the specified number of values
+uint64_t* NS_Clustering::TDotDataArena::Allocate(const std::size_t Count)
+{
+    Blocks.push_back(TBlock{ std::unique_ptr<uint64_t[]>(new uint64_t[Count]), Count });
+    Size += Count;
+
+    return Blocks.back().Values.get();
+}
+
+// Get the total number of values in all blocks
+std::size_t NS_Clustering::TDotDataArena::Get_Size(void) const noexcept
+{
+    return Size;
+}
+
+// Get the memory of blocks in bytes
+std::size_t NS_Clustering::TDotDataArena::Get_Memory_Usage(void) const noexcept
+{
+    return Size * sizeof(uint64_t) + Blocks.capacity() * sizeof(TBlock);
+}
+
+// Note the end of loading of dots
+bool NS_Clustering::TDotDataArena::Note_Load(void) noexcept
+{
+    if (Base_Size == 0) // the first load
+    {
+        Base_Size = Size;
+        return false;
+    }
+
+    return Size >= 2 * Base_Size;
+}
+
+// Move the values of datasets that refer to the arena into one new block and free the old blocks
+std::size_t NS_Clustering::TDotDataArena::Compact(const std::vector<TDotData*>& VecData)
+{
+    using TRange = std::pair<const uint64_t*, const uint64_t*>;
+
+    const std::less<const uint64_t*> less;
+
+    // Ranges of blocks ordered by address, the dataset refers to the arena if its values are inside one of them
+    std::vector<TRange> ranges;
+
+    ranges.reserve(Blocks.size());
+
+    for (const TBlock& block : Blocks)
+        ranges.emplace_back(block.Values.get(), block.Values.get() + block.Count);
+
+    std::sort(ranges.begin(), ranges.end(), [&less](const TRange& A, const TRange& B) { return less(A.first, B.first); });
+
+    const auto in_arena = [&ranges, &less](const TDotData* const Data) noexcept
+    {
+        if (!Data->Is_Referred())
+            return false;
+
+        const auto next = std::upper_bound(ranges.cbegin(), ranges.cend(), Data->begin(), [&less](const uint64_t* const Values, const TRange& Range) { return less(Values, Range.first); });
+
+        return next != ranges.cbegin() && less(Data->begin(), (next - 1)->second);
+    };
+
+    std::size_t live = 0; // values that are referred by datasets
+
+    for (const TDotData* const data : VecData)
+    {
+        if (in_arena(data))
+            live += data->size();
+    }
+
+    if (live == Size && Blocks.size() <= 1) // nothing to free
+    {
+        Base_Size = Size;
+        return 0;
+    }
+
+    TDotDataArena  arena;                                             // new block, then the old blocks that are freed with it
+    uint64_t*      values  = live > 0 ? arena.Allocate(live) : nullptr;
+
+    for (TDotData* const data : VecData)
+    {
+        if (in_arena(data)) // the old blocks are checked, so the moved datasets are not moved again
+        {
+            const uint32_t count = static_cast<uint32_t>(data->size());
+
+            std::copy(data->begin(), data->end(), values);
+            data->Refer(values, count);
+            values += count;
+        }
+    }
+
+    const std::size_t freed = Size - live;
+
+    Blocks.swap(arena.Blocks);
+    Size       = live;
+    Base_Size  = live;
+
+    return freed;
+}
+
+// Free all blocks
+void NS_Clustering::TDotDataArena::Clear(void) noexcept
+{
+    Blocks.clear();
+    Size       = 0;
+    Base_Size  = 0;
+}
+/****************************************************************************************************/
+
+
+/*** TDotData ***************************************************************************************/
+NS_Clustering::TDotData::TDotData(void) noexcept :
+    Value   (0),
+    Size    (0),
+    Capacity(0)
+{}
+
+NS_Clustering::TDotData::TDotData(const TDotData& Obj) :
+    Value   (0),
+    Size    (0),
+    Capacity(0)
+{
+    Assign(Obj.begin(), Obj.end());
+}
+
+NS_Clustering::TDotData::~TDotData(void) noexcept
+{
+    if (Capacity > 0)
+        delete[] Arr;
+}
+
+NS_Clustering::TDotData& NS_Clustering::TDotData::operator = (const TDotData& Obj)
+{
+    if (this != &Obj)
+        Assign(Obj.begin(), Obj.end());
+
+    return *this;
+}
+
+// Get the address of the values for change, own buffer is created if there is not enough space in it
+uint64_t* NS_Clustering::TDotData::Reserve(const uint32_t Count)
+{
+    if (Count <= 1 && Capacity == 0) // single value is stored inside the object
+        return &Value;
+
+    if (Count > Capacity) // need a new own buffer
+    {
+        const uint32_t  capacity  = std::max(Count, Size < 2 ? 2U : Size + Size / 2);
+        uint64_t*       arr       = new uint64_t[capacity];
+
+        std::copy(begin(), end(), arr); // keep the current values
+
+        if (Capacity > 0)
+            delete[] Arr;
+
+        Arr       = arr;
+        Capacity  = capacity;
+    }
+
+    return Arr;
+}
+
+// Get the number of values
+std::size_t NS_Clustering::TDotData::size(void) const noexcept
+{
+    return Size;
+}
+
+// Check for absence of values
+bool NS_Clustering::TDotData::empty(void) const noexcept
+{
+    return Size == 0;
+}
+
+// Get the sorted values
+const uint64_t* NS_Clustering::TDotData::begin(void) const noexcept
+{
+    return Capacity > 0 || Size > 1 ? Arr : &Value;
+}
+
+const uint64_t* NS_Clustering::TDotData::end(void) const noexcept
+{
+    return begin() + Size;
+}
+
+const uint64_t* NS_Clustering::TDotData::cbegin(void) const noexcept
+{
+    return begin();
+}
+
+const uint64_t* NS_Clustering::TDotData::cend(void) const noexcept
+{
+    return end();
+}
+
+// Add value, if there is no such value yet
+bool NS_Clustering::TDotData::insert(const uint64_t Data)
+{
+    const uint64_t* const  first     = begin();
+    const std::size_t      position  = std::lower_bound(first, first + Size, Data) - first;
+
+    if (position < Size && first[position] == Data) // already exists
+        return false;
+
+    uint64_t* const arr = Reserve(Size + 1);
+
+    std::copy_backward(arr + position, arr + Size, arr + Size + 1); // shift larger values
+    arr[position] = Data;
+    ++Size;
+
+    return true;
+}
+
+// Set sorted unique values
+void NS_Clustering::TDotData::Assign(const uint64_t* const First, const uint64_t* const Last)
+{
+    const uint32_t count = static_cast<uint32_t>(Last - First);
+
+    clear();
+    std::copy(First, Last, Reserve(count));
+    Size = count;
+}
+
+// Refer to sorted unique values stored outside the object
+void NS_Clustering::TDotData::Refer(const uint64_t* const First, const uint32_t Count)
+{
+    if (Count > 1)
+    {
+        clear();
+
+        Arr   = const_cast<uint64_t*>(First); // never changed through the dataset: own buffer is created on the first change
+        Size  = Count;
+    }
+    else
+        Assign(First, First + Count);
+}
+
+// Whether the values are stored outside the object
+bool NS_Clustering::TDotData::Is_Referred(void) const noexcept
+{
+    return Capacity == 0 && Size > 1;
+}
+
+// Remove all values
+void NS_Clustering::TDotData::clear(void) noexcept
+{
+    if (Capacity > 0)
+        delete[] Arr;
+
+    Value     = 0;
+    Size      = 0;
+    Capacity  = 0;
+}
+
+// Get the memory of own buffer in bytes
+std::size_t NS_Clustering::TDotData::Get_Memory_Usage(void) const noexcept
+{
+    return Capacity * sizeof(uint64_t);
+}
+/****************************************************************************************************/
+
+
 /*** TDot *******************************************************************************************/
 NS_Clustering::TDot::TDot(void) noexcept :
     TClusteringElem(ID_DOT, 0.0, 0.0, Dot_Radius, false)
@@ -129,24 +897,42 @@ std::size_t NS_Clustering::TDot::Get_Count(void) const noexcept
     return SetData.size();
 }
 
+// Get the number of dots
+std::size_t NS_Clustering::TDot::Get_Dot_Count(void) const noexcept
+{
+    return 1;
+}
+
 // Get data for all dots
 std::set<uint64_t> NS_Clustering::TDot::Get_Data(void) const noexcept
 {
-    return SetData;
+    return std::set<uint64_t>(SetData.cbegin(), SetData.cend());
+}
+
+// Get the memory of the dataset outside the object in bytes
+std::size_t NS_Clustering::TDot::Get_Member_Memory_Usage(void) const noexcept
+{
+    return SetData.Get_Memory_Usage();
 }
 /****************************************************************************************************/
 
 
 /*** TCluster_1 *************************************************************************************/
 NS_Clustering::TCluster_1::TCluster_1(void) noexcept :
-    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false)
+    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {}
 
 NS_Clustering::TCluster_1::TCluster_1(TDot* const Dot) noexcept :
-    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false)
+    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
     MapDot[TCoordKey(Dot->X, Dot->Y)]  = Dot;   // add dot
     Dot->InCluster                     = true;  // dot is now in the cluster
+    Dot->Parent                        = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot, DataCount, DotCount); // count its data and dots
 
     // Set center coordinates
     X  = Dot->X;
@@ -154,18 +940,28 @@ NS_Clustering::TCluster_1::TCluster_1(TDot* const Dot) noexcept :
 }
 
 NS_Clustering::TCluster_1::TCluster_1(TDot* const Dot1, TDot* const Dot2) noexcept :
-    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false)
+    TClusteringElem(ID_CLUSTER_1, 0.0, 0.0, Cluster_1_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot[TCoordKey(Dot1->X, Dot1->Y)]  = Dot1;  // add dot 1
     Dot1->InCluster                      = true;  // dot 1 is now in the cluster
+    Dot1->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot1, DataCount, DotCount); // count its data and dots
     MapDot[TCoordKey(Dot2->X, Dot2->Y)]  = Dot2;  // add dot 2
     Dot2->InCluster                      = true;  // dot 2 is now in the cluster
+    Dot2->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot2, DataCount, DotCount); // count its data and dots
     Set_Center();                                 // calculate center coordinates
 }
 
 // Calculate center coordinates
 void NS_Clustering::TCluster_1::Set_Center(void) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Set_Center_Count);
+
     if (!MapDot.empty())
     {
         const std::size_t  size   = MapDot.size();
@@ -178,8 +974,8 @@ void NS_Clustering::TCluster_1::Set_Center(void) noexcept
             sum_y  += dot.first.Y;
         }
 
-        X  = sum_x / size;
-        Y  = sum_y / size;
+        X  = To_Coord(sum_x / size);
+        Y  = To_Coord(sum_y / size);
     }
     else
     {
@@ -191,7 +987,13 @@ void NS_Clustering::TCluster_1::Set_Center(void) noexcept
 // Get the amount of data
 std::size_t NS_Clustering::TCluster_1::Get_Count(void) const noexcept
 {
-    return ClusteringElem_Get_Count(MapDot);
+    return DataCount;
+}
+
+// Get the number of dots
+std::size_t NS_Clustering::TCluster_1::Get_Dot_Count(void) const noexcept
+{
+    return DotCount;
 }
 
 // Get data for all dots
@@ -199,8 +1001,7 @@ std::set<uint64_t> NS_Clustering::TCluster_1::Get_Data(void) const noexcept
 {
     std::set<uint64_t> result;
 
-    for (const auto& dot : MapDot)
-        result.insert(dot.second->SetData.cbegin(), dot.second->SetData.cend());
+    For_Each_Dot([&result](const TDot* const Dot) { result.insert(Dot->SetData.cbegin(), Dot->SetData.cend()); return true; });
 
     return result;
 }
@@ -212,11 +1013,17 @@ bool NS_Clustering::TCluster_1::Check_Dot(const TDot* const Dot) const noexcept
 }
 
 // Add dot
-void NS_Clustering::TCluster_1::Add_Dot(TDot* const Dot) noexcept
+void NS_Clustering::TCluster_1::Add_Dot(TDot* const Dot, const bool Update_Center) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot[TCoordKey(Dot->X, Dot->Y)]  = Dot;   // add dot
     Dot->InCluster                     = true;  // dot is now in the cluster
-    Set_Center();                               // calculate center coordinates
+    Dot->Parent                        = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot, DataCount, DotCount); // count its data and dots
+
+    if (Update_Center)
+        Set_Center(); // calculate center coordinates
 }
 
 // Check if it is worth adding a cluster_1
@@ -228,34 +1035,60 @@ bool NS_Clustering::TCluster_1::Check_Cluster_1(const TCluster_1* const Cluster_
 // Absorb cluster_1
 void NS_Clustering::TCluster_1::Eat_Cluster_1(TCluster_1*& Cluster_1) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot.insert(Cluster_1->MapDot.cbegin(), Cluster_1->MapDot.cend()); // absorb all dots
 
+    // Absorbed elements are now contained in this cluster
+    Set_Parent(Cluster_1->MapDot, this);
+
+    DataCount  += Cluster_1->DataCount;  // absorb amount of data
+    DotCount   += Cluster_1->DotCount;   // absorb number of dots
+
     // Cluster is absorbed
     delete Cluster_1;
     Cluster_1 = nullptr;
 
     Set_Center(); // calculate center coordinates
 }
+
+// Get the memory of maps of members in bytes
+std::size_t NS_Clustering::TCluster_1::Get_Member_Memory_Usage(void) const noexcept
+{
+    return Map_Get_Memory_Usage(MapDot);
+}
 /****************************************************************************************************/
 
 
 /*** TCluster_2 *************************************************************************************/
 NS_Clustering::TCluster_2::TCluster_2(void) noexcept :
-    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false)
+    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {}
 
 NS_Clustering::TCluster_2::TCluster_2(TDot* const Dot1, TDot* const Dot2) noexcept :
-    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false)
+    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot[TCoordKey(Dot1->X, Dot1->Y)]  = Dot1;  // add dot 1
     Dot1->InCluster                      = true;  // dot 1 is now in the cluster
+    Dot1->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot1, DataCount, DotCount); // count its data and dots
     MapDot[TCoordKey(Dot2->X, Dot2->Y)]  = Dot2;  // add dot 2
     Dot2->InCluster                      = true;  // dot 2 is now in the cluster
+    Dot2->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot2, DataCount, DotCount); // count its data and dots
     Set_Center();                                 // calculate center coordinates
 }
 
 NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem) noexcept :
-    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false)
+    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_2)
     {
@@ -267,6 +1100,8 @@ NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem) noe
         }
 
         ClusteringElem->InCluster = true; // element is now in the cluster
+        ClusteringElem->Parent    = this; // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
 
         // Set center coordinates
         X  = ClusteringElem->X;
@@ -275,8 +1110,12 @@ NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem) noe
 }
 
 NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem1, TClusteringElem* const ClusteringElem2) noexcept :
-    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false)
+    TClusteringElem(ID_CLUSTER_2, 0.0, 0.0, Cluster_2_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem1->Get_ClusteringElem_Id() < ID_CLUSTER_2 && ClusteringElem2->Get_ClusteringElem_Id() < ID_CLUSTER_2)
     {
         switch (ClusteringElem1->Get_ClusteringElem_Id())
@@ -294,7 +1133,11 @@ NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem1, TC
         }
 
         ClusteringElem1->InCluster  = true;  // element 1 is now in the cluster
+        ClusteringElem1->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem1, DataCount, DotCount); // count its data and dots
         ClusteringElem2->InCluster  = true;  // element 2 is now in the cluster
+        ClusteringElem2->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem2, DataCount, DotCount); // count its data and dots
         Set_Center();                        // calculate center coordinates
     }
 }
@@ -302,6 +1145,8 @@ NS_Clustering::TCluster_2::TCluster_2(TClusteringElem* const ClusteringElem1, TC
 // Calculate center coordinates
 void NS_Clustering::TCluster_2::Set_Center(void) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Set_Center_Count);
+
     if (!MapDot.empty() || !MapCluster_1.empty())
     {
         const std::size_t  size   = MapDot.size() + MapCluster_1.size();
@@ -320,8 +1165,8 @@ void NS_Clustering::TCluster_2::Set_Center(void) noexcept
             sum_y  += c1.first.Y;
         }
 
-        X  = sum_x / size;
-        Y  = sum_y / size;
+        X  = To_Coord(sum_x / size);
+        Y  = To_Coord(sum_y / size);
     }
     else
     {
@@ -333,7 +1178,13 @@ void NS_Clustering::TCluster_2::Set_Center(void) noexcept
 // Get the amount of data
 std::size_t NS_Clustering::TCluster_2::Get_Count(void) const noexcept
 {
-    return ClusteringElem_Get_Count(MapDot) + ClusteringElem_Get_Count(MapCluster_1);
+    return DataCount;
+}
+
+// Get the number of dots
+std::size_t NS_Clustering::TCluster_2::Get_Dot_Count(void) const noexcept
+{
+    return DotCount;
 }
 
 // Get data for all dots
@@ -341,15 +1192,7 @@ std::set<uint64_t> NS_Clustering::TCluster_2::Get_Data(void) const noexcept
 {
     std::set<uint64_t> result;
 
-    for (const auto& dot : MapDot)
-        result.insert(dot.second->SetData.cbegin(), dot.second->SetData.cend());
-
-    for (const auto& c1 : MapCluster_1)
-    {
-        const std::set<uint64_t> c1_data = c1.second->Get_Data();
-
-        result.insert(c1_data.cbegin(), c1_data.cend());
-    }
+    For_Each_Dot([&result](const TDot* const Dot) { result.insert(Dot->SetData.cbegin(), Dot->SetData.cend()); return true; });
 
     return result;
 }
@@ -361,8 +1204,10 @@ bool NS_Clustering::TCluster_2::Check_ClusteringElem(const TClusteringElem* cons
 }
 
 // Add clustering element
-void NS_Clustering::TCluster_2::Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept
+void NS_Clustering::TCluster_2::Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_2)
     {
         switch (ClusteringElem->Get_ClusteringElem_Id())
@@ -373,7 +1218,11 @@ void NS_Clustering::TCluster_2::Add_ClusteringElem(TClusteringElem* const Cluste
         }
 
         ClusteringElem->InCluster = true;  // element is now in the cluster
-        Set_Center();                      // calculate center coordinates
+        ClusteringElem->Parent    = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
+
+        if (Update_Center)
+            Set_Center(); // calculate center coordinates
     }
 }
 
@@ -386,35 +1235,62 @@ bool NS_Clustering::TCluster_2::Check_Cluster_2(const TCluster_2* const Cluster_
 // Absorb cluster_2
 void NS_Clustering::TCluster_2::Eat_Cluster_2(TCluster_2*& Cluster_2) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot.insert(Cluster_2->MapDot.cbegin(), Cluster_2->MapDot.cend());                    // absorb all dots
     MapCluster_1.insert(Cluster_2->MapCluster_1.cbegin(), Cluster_2->MapCluster_1.cend());  // absorb all clusters_1
 
+    // Absorbed elements are now contained in this cluster
+    Set_Parent(Cluster_2->MapDot, this);
+    Set_Parent(Cluster_2->MapCluster_1, this);
+
+    DataCount  += Cluster_2->DataCount;  // absorb amount of data
+    DotCount   += Cluster_2->DotCount;   // absorb number of dots
+
     // Cluster is absorbed
     delete Cluster_2;
     Cluster_2 = nullptr;
 
     Set_Center(); // calculate center coordinates
 }
+
+// Get the memory of maps of members in bytes
+std::size_t NS_Clustering::TCluster_2::Get_Member_Memory_Usage(void) const noexcept
+{
+    return Map_Get_Memory_Usage(MapDot) + Map_Get_Memory_Usage(MapCluster_1);
+}
 /****************************************************************************************************/
 
 
 /*** TCluster_3 *************************************************************************************/
 NS_Clustering::TCluster_3::TCluster_3(void) noexcept :
-    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false)
+    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {}
 
 NS_Clustering::TCluster_3::TCluster_3(TDot* const Dot1, TDot* const Dot2) noexcept :
-    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false)
+    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot[TCoordKey(Dot1->X, Dot1->Y)]  = Dot1;  // add dot 1
     Dot1->InCluster                      = true;  // dot 1 is now in the cluster
+    Dot1->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot1, DataCount, DotCount); // count its data and dots
     MapDot[TCoordKey(Dot2->X, Dot2->Y)]  = Dot2;  // add dot 2
     Dot2->InCluster                      = true;  // dot 2 is now in the cluster
+    Dot2->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot2, DataCount, DotCount); // count its data and dots
     Set_Center();                                 // calculate center coordinates
 }
 
 NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem) noexcept :
-    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false)
+    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_3)
     {
@@ -427,6 +1303,8 @@ NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem) noe
         }
 
         ClusteringElem->InCluster = true; // element is now in the cluster
+        ClusteringElem->Parent    = this; // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
 
         // Set center coordinates
         X  = ClusteringElem->X;
@@ -435,8 +1313,12 @@ NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem) noe
 }
 
 NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem1, TClusteringElem* const ClusteringElem2) noexcept :
-    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false)
+    TClusteringElem(ID_CLUSTER_3, 0.0, 0.0, Cluster_3_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem1->Get_ClusteringElem_Id() < ID_CLUSTER_3 && ClusteringElem2->Get_ClusteringElem_Id() < ID_CLUSTER_3)
     {
         switch (ClusteringElem1->Get_ClusteringElem_Id())
@@ -456,7 +1338,11 @@ NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem1, TC
         }
 
         ClusteringElem1->InCluster  = true;  // element 1 is now in the cluster
+        ClusteringElem1->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem1, DataCount, DotCount); // count its data and dots
         ClusteringElem2->InCluster  = true;  // element 2 is now in the cluster
+        ClusteringElem2->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem2, DataCount, DotCount); // count its data and dots
         Set_Center();                        // calculate center coordinates
     }
 }
@@ -464,6 +1350,8 @@ NS_Clustering::TCluster_3::TCluster_3(TClusteringElem* const ClusteringElem1, TC
 // Calculate center coordinates
 void NS_Clustering::TCluster_3::Set_Center(void) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Set_Center_Count);
+
     if (!MapDot.empty() || !MapCluster_1.empty() || !MapCluster_2.empty())
     {
         const std::size_t  size   = MapDot.size() + MapCluster_1.size() + MapCluster_2.size();
@@ -488,8 +1376,8 @@ void NS_Clustering::TCluster_3::Set_Center(void) noexcept
             sum_y  += c2.first.Y;
         }
 
-        X  = sum_x / size;
-        Y  = sum_y / size;
+        X  = To_Coord(sum_x / size);
+        Y  = To_Coord(sum_y / size);
     }
     else
     {
@@ -501,7 +1389,13 @@ void NS_Clustering::TCluster_3::Set_Center(void) noexcept
 // Get the amount of data
 std::size_t NS_Clustering::TCluster_3::Get_Count(void) const noexcept
 {
-    return ClusteringElem_Get_Count(MapDot) + ClusteringElem_Get_Count(MapCluster_1) + ClusteringElem_Get_Count(MapCluster_2);
+    return DataCount;
+}
+
+// Get the number of dots
+std::size_t NS_Clustering::TCluster_3::Get_Dot_Count(void) const noexcept
+{
+    return DotCount;
 }
 
 // Get data for all dots
@@ -509,22 +1403,7 @@ std::set<uint64_t> NS_Clustering::TCluster_3::Get_Data(void) const noexcept
 {
     std::set<uint64_t> result;
 
-    for (const auto& dot : MapDot)
-        result.insert(dot.second->SetData.cbegin(), dot.second->SetData.cend());
-
-    for (const auto& c1 : MapCluster_1)
-    {
-        const std::set<uint64_t> c1_data = c1.second->Get_Data();
-
-        result.insert(c1_data.cbegin(), c1_data.cend());
-    }
-
-    for (const auto& c2 : MapCluster_2)
-    {
-        const std::set<uint64_t> c2_data = c2.second->Get_Data();
-
-        result.insert(c2_data.cbegin(), c2_data.cend());
-    }
+    For_Each_Dot([&result](const TDot* const Dot) { result.insert(Dot->SetData.cbegin(), Dot->SetData.cend()); return true; });
 
     return result;
 }
@@ -536,8 +1415,10 @@ bool NS_Clustering::TCluster_3::Check_ClusteringElem(const TClusteringElem* cons
 }
 
 // Add clustering element
-void NS_Clustering::TCluster_3::Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept
+void NS_Clustering::TCluster_3::Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_3)
     {
         switch (ClusteringElem->Get_ClusteringElem_Id())
@@ -549,7 +1430,11 @@ void NS_Clustering::TCluster_3::Add_ClusteringElem(TClusteringElem* const Cluste
         }
 
         ClusteringElem->InCluster = true;  // element is now in the cluster
-        Set_Center();                      // calculate center coordinates
+        ClusteringElem->Parent    = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
+
+        if (Update_Center)
+            Set_Center(); // calculate center coordinates
     }
 }
 
@@ -562,36 +1447,64 @@ bool NS_Clustering::TCluster_3::Check_Cluster_3(const TCluster_3* const Cluster_
 // Absorb cluster_3
 void NS_Clustering::TCluster_3::Eat_Cluster_3(TCluster_3*& Cluster_3) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot.insert(Cluster_3->MapDot.cbegin(), Cluster_3->MapDot.cend());                    // absorb all dots
     MapCluster_1.insert(Cluster_3->MapCluster_1.cbegin(), Cluster_3->MapCluster_1.cend());  // absorb all clusters_1
     MapCluster_2.insert(Cluster_3->MapCluster_2.cbegin(), Cluster_3->MapCluster_2.cend());  // absorb all clusters_2
 
+    // Absorbed elements are now contained in this cluster
+    Set_Parent(Cluster_3->MapDot, this);
+    Set_Parent(Cluster_3->MapCluster_1, this);
+    Set_Parent(Cluster_3->MapCluster_2, this);
+
+    DataCount  += Cluster_3->DataCount;  // absorb amount of data
+    DotCount   += Cluster_3->DotCount;   // absorb number of dots
+
     // Cluster is absorbed
     delete Cluster_3;
     Cluster_3 = nullptr;
 
     Set_Center(); // calculate center coordinates
 }
+
+// Get the memory of maps of members in bytes
+std::size_t NS_Clustering::TCluster_3::Get_Member_Memory_Usage(void) const noexcept
+{
+    return Map_Get_Memory_Usage(MapDot) + Map_Get_Memory_Usage(MapCluster_1) + Map_Get_Memory_Usage(MapCluster_2);
+}
 /****************************************************************************************************/
 
 
 /*** TCluster_4 *************************************************************************************/
 NS_Clustering::TCluster_4::TCluster_4(void) noexcept :
-    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false)
+    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {}
 
 NS_Clustering::TCluster_4::TCluster_4(TDot* const Dot1, TDot* const Dot2) noexcept :
-    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false)
+    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot[TCoordKey(Dot1->X, Dot1->Y)]  = Dot1;  // add dot 1
     Dot1->InCluster                      = true;  // dot 1 is now in the cluster
+    Dot1->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot1, DataCount, DotCount); // count its data and dots
     MapDot[TCoordKey(Dot2->X, Dot2->Y)]  = Dot2;  // add dot 2
     Dot2->InCluster                      = true;  // dot 2 is now in the cluster
+    Dot2->Parent                         = this;  // the cluster contains it now
+    Add_ClusteringElem_Counts(Dot2, DataCount, DotCount); // count its data and dots
     Set_Center();                                 // calculate center coordinates
 }
 
 NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem) noexcept :
-    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false)
+    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_4)
     {
@@ -605,6 +1518,8 @@ NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem) noe
         }
 
         ClusteringElem->InCluster = true; // element is now in the cluster
+        ClusteringElem->Parent    = this; // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
 
         // Set center coordinates
         X  = ClusteringElem->X;
@@ -613,8 +1528,12 @@ NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem) noe
 }
 
 NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem1, TClusteringElem* const ClusteringElem2) noexcept :
-    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false)
+    TClusteringElem(ID_CLUSTER_4, 0.0, 0.0, Cluster_4_Radius, false),
+    DataCount      (0),
+    DotCount       (0)
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem1->Get_ClusteringElem_Id() < ID_CLUSTER_4 && ClusteringElem2->Get_ClusteringElem_Id() < ID_CLUSTER_4)
     {
         switch (ClusteringElem1->Get_ClusteringElem_Id())
@@ -636,7 +1555,11 @@ NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem1, TC
         }
 
         ClusteringElem1->InCluster  = true;  // element 1 is now in the cluster
+        ClusteringElem1->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem1, DataCount, DotCount); // count its data and dots
         ClusteringElem2->InCluster  = true;  // element 2 is now in the cluster
+        ClusteringElem2->Parent     = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem2, DataCount, DotCount); // count its data and dots
         Set_Center();                        // calculate center coordinates
     }
 }
@@ -644,6 +1567,8 @@ NS_Clustering::TCluster_4::TCluster_4(TClusteringElem* const ClusteringElem1, TC
 // Calculate center coordinates
 void NS_Clustering::TCluster_4::Set_Center(void) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Set_Center_Count);
+
     if (!MapDot.empty() || !MapCluster_1.empty() || !MapCluster_2.empty() || !MapCluster_3.empty())
     {
         const std::size_t  size   = MapDot.size() + MapCluster_1.size() + MapCluster_2.size() + MapCluster_3.size();
@@ -674,8 +1599,8 @@ void NS_Clustering::TCluster_4::Set_Center(void) noexcept
             sum_y  += c3.first.Y;
         }
 
-        X  = sum_x / size;
-        Y  = sum_y / size;
+        X  = To_Coord(sum_x / size);
+        Y  = To_Coord(sum_y / size);
     }
     else
     {
@@ -687,7 +1612,13 @@ void NS_Clustering::TCluster_4::Set_Center(void) noexcept
 // Get the amount of data
 std::size_t NS_Clustering::TCluster_4::Get_Count(void) const noexcept
 {
-    return ClusteringElem_Get_Count(MapDot) + ClusteringElem_Get_Count(MapCluster_1) + ClusteringElem_Get_Count(MapCluster_2) + ClusteringElem_Get_Count(MapCluster_3);
+    return DataCount;
+}
+
+// Get the number of dots
+std::size_t NS_Clustering::TCluster_4::Get_Dot_Count(void) const noexcept
+{
+    return DotCount;
 }
 
 // Get data for all dots
@@ -695,29 +1626,7 @@ std::set<uint64_t> NS_Clustering::TCluster_4::Get_Data(void) const noexcept
 {
     std::set<uint64_t> result;
 
-    for (const auto& dot : MapDot)
-        result.insert(dot.second->SetData.cbegin(), dot.second->SetData.cend());
-
-    for (const auto& c1 : MapCluster_1)
-    {
-        const std::set<uint64_t> c1_data = c1.second->Get_Data();
-
-        result.insert(c1_data.cbegin(), c1_data.cend());
-    }
-
-    for (const auto& c2 : MapCluster_2)
-    {
-        const std::set<uint64_t> c2_data = c2.second->Get_Data();
-
-        result.insert(c2_data.cbegin(), c2_data.cend());
-    }
-
-    for (const auto& c3 : MapCluster_3)
-    {
-        const std::set<uint64_t> c3_data = c3.second->Get_Data();
-
-        result.insert(c3_data.cbegin(), c3_data.cend());
-    }
+    For_Each_Dot([&result](const TDot* const Dot) { result.insert(Dot->SetData.cbegin(), Dot->SetData.cend()); return true; });
 
     return result;
 }
@@ -729,8 +1638,10 @@ bool NS_Clustering::TCluster_4::Check_ClusteringElem(const TClusteringElem* cons
 }
 
 // Add clustering element
-void NS_Clustering::TCluster_4::Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept
+void NS_Clustering::TCluster_4::Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     if (ClusteringElem->Get_ClusteringElem_Id() < ID_CLUSTER_4)
     {
         switch (ClusteringElem->Get_ClusteringElem_Id())
@@ -743,7 +1654,11 @@ void NS_Clustering::TCluster_4::Add_ClusteringElem(TClusteringElem* const Cluste
         }
 
         ClusteringElem->InCluster = true;  // element is now in the cluster
-        Set_Center();                      // calculate center coordinates
+        ClusteringElem->Parent    = this;  // the cluster contains it now
+        Add_ClusteringElem_Counts(ClusteringElem, DataCount, DotCount); // count its data and dots
+
+        if (Update_Center)
+            Set_Center(); // calculate center coordinates
     }
 }
 
@@ -756,41 +1671,328 @@ bool NS_Clustering::TCluster_4::Check_Cluster_4(const TCluster_4* const Cluster_
 // Absorb cluster_4
 void NS_Clustering::TCluster_4::Eat_Cluster_4(TCluster_4*& Cluster_4) noexcept
 {
+    SIMPLE_CLUSTERING_COUNT(Merge_Count);
+
     MapDot.insert(Cluster_4->MapDot.cbegin(), Cluster_4->MapDot.cend());                    // absorb all dots
     MapCluster_1.insert(Cluster_4->MapCluster_1.cbegin(), Cluster_4->MapCluster_1.cend());  // absorb all clusters_1
     MapCluster_2.insert(Cluster_4->MapCluster_2.cbegin(), Cluster_4->MapCluster_2.cend());  // absorb all clusters_2
     MapCluster_3.insert(Cluster_4->MapCluster_3.cbegin(), Cluster_4->MapCluster_3.cend());  // absorb all clusters_3
 
+    // Absorbed elements are now contained in this cluster
+    Set_Parent(Cluster_4->MapDot, this);
+    Set_Parent(Cluster_4->MapCluster_1, this);
+    Set_Parent(Cluster_4->MapCluster_2, this);
+    Set_Parent(Cluster_4->MapCluster_3, this);
+
+    DataCount  += Cluster_4->DataCount;  // absorb amount of data
+    DotCount   += Cluster_4->DotCount;   // absorb number of dots
+
     // Cluster is absorbed
     delete Cluster_4;
     Cluster_4 = nullptr;
 
     Set_Center(); // calculate center coordinates
 }
+
+// Get the memory of maps of members in bytes
+std::size_t NS_Clustering::TCluster_4::Get_Member_Memory_Usage(void) const noexcept
+{
+    return Map_Get_Memory_Usage(MapDot) + Map_Get_Memory_Usage(MapCluster_1) + Map_Get_Memory_Usage(MapCluster_2) + Map_Get_Memory_Usage(MapCluster_3);
+}
+/****************************************************************************************************/
+
+
+/*** TTagIndex **************************************************************************************/
+namespace NS_Clustering
+{
+    // Add clustering elements of the set with tag to the index
+    template <typename Type> void Add_To_TagIndex(const std::map<TCoordKey, Type*>& MapClusteringElem, std::unordered_multimap<uint64_t, const TClusteringElem*>& MapTag)
+    {
+        for (const auto& ce : MapClusteringElem)
+        {
+            if (ce.second->Tag != 0xFFFFFFFFFFFFFFFFULL)
+                MapTag.emplace(ce.second->Tag, ce.second);
+        }
+    }
+}
+
+// Build index for all clustering elements with tag
+void NS_Clustering::TTagIndex::Build(
+    const TMapDot&        MapDot,
+    const TMapCluster_1&  MapCluster_1,
+    const TMapCluster_2&  MapCluster_2,
+    const TMapCluster_3&  MapCluster_3,
+    const TMapCluster_4&  MapCluster_4)
+{
+    MapTag.clear();
+
+    Add_To_TagIndex(MapDot, MapTag);
+    Add_To_TagIndex(MapCluster_1, MapTag);
+    Add_To_TagIndex(MapCluster_2, MapTag);
+    Add_To_TagIndex(MapCluster_3, MapTag);
+    Add_To_TagIndex(MapCluster_4, MapTag);
+}
+
+// Clear index
+void NS_Clustering::TTagIndex::Clear(void) noexcept
+{
+    MapTag.clear();
+}
+
+// Get the memory of the index in bytes
+std::size_t NS_Clustering::TTagIndex::Get_Memory_Usage(void) const noexcept
+{
+    return MapTag.bucket_count() * sizeof(void*) + MapTag.size() * (sizeof(decltype(MapTag)::value_type) + Hash_Node_Overhead);
+}
+
+// Does the clustering element or any clustering element inside it have the tag
+bool NS_Clustering::TTagIndex::Is_Have_Tag_Inside(const TClusteringElem* const ClusteringElem, const uint64_t Tag) const noexcept
+{
+    const auto range = MapTag.equal_range(Tag); // elements with the tag
+
+    for (auto cit = range.first; cit != range.second; ++cit)
+    {
+        // Go up through the clusters that contain the element with the tag
+        for (const TClusteringElem* elem = cit->second; elem; elem = elem->Parent)
+        {
+            if (elem == ClusteringElem)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Get all clustering elements that have the tag inside
+void NS_Clustering::TTagIndex::Get_Elems_With_Tag_Inside(const uint64_t Tag, std::unordered_set<const TClusteringElem*>& SetClusteringElem) const
+{
+    const auto range = MapTag.equal_range(Tag); // elements with the tag
+
+    for (auto cit = range.first; cit != range.second; ++cit)
+    {
+        // The element and all clusters that contain it, until an already added cluster
+        for (const TClusteringElem* elem = cit->second; elem && SetClusteringElem.insert(elem).second; elem = elem->Parent) {}
+    }
+}
 /****************************************************************************************************/
 
 
+// Change the amount of data and the number of dots of all clusters that contain the clustering element
+void NS_Clustering::Change_Counts_Of_Parents(const TClusteringElem* const ClusteringElem, const std::ptrdiff_t DataCount_Delta, const std::ptrdiff_t DotCount_Delta) noexcept
+{
+    // Clusters are owned by non-constant sets, so their counters can be changed
+    for (const TClusteringElem* parent = ClusteringElem->Parent; parent; parent = parent->Parent)
+    {
+        switch (parent->Get_ClusteringElem_Id())
+        {
+            case ID_CLUSTER_1: { auto c1 = const_cast<TCluster_1*>(static_cast<const TCluster_1*>(parent)); c1->DataCount += DataCount_Delta; c1->DotCount += DotCount_Delta; break; }
+            case ID_CLUSTER_2: { auto c2 = const_cast<TCluster_2*>(static_cast<const TCluster_2*>(parent)); c2->DataCount += DataCount_Delta; c2->DotCount += DotCount_Delta; break; }
+            case ID_CLUSTER_3: { auto c3 = const_cast<TCluster_3*>(static_cast<const TCluster_3*>(parent)); c3->DataCount += DataCount_Delta; c3->DotCount += DotCount_Delta; break; }
+            case ID_CLUSTER_4: { auto c4 = const_cast<TCluster_4*>(static_cast<const TCluster_4*>(parent)); c4->DataCount += DataCount_Delta; c4->DotCount += DotCount_Delta; break; }
+            default: break;
+        }
+    }
+}
+
+// Add dots that are not indexed yet to the end of the dense array of dots
+void NS_Clustering::Index_Dots(const TMapDot& MapDot, TVecDot& VecDot)
+{
+    TTraceScope trace_scope("Index_Dots");
+
+    for (const auto& dot : MapDot)
+    {
+        if (dot.second->Index == INDEX_NONE)
+            Index_ClusteringElem(dot.second, VecDot);
+    }
+}
+
+// Project geographic coordinates to Web Mercator
+void NS_Clustering::Project_Web_Mercator(
+    const uint32_t       ArrSize,
+    const double* const  Lon_Arr,
+    const double* const  Lat_Arr,
+    double* const        X_Arr,
+    double* const        Y_Arr,
+    const uint32_t       ThreadCount)
+{
+    TTraceScope trace_scope("Project_Web_Mercator");
+
+    Process_Parts(ArrSize, ThreadCount, "Project_Web_Mercator_Part", [Lon_Arr, Lat_Arr, X_Arr, Y_Arr](const uint32_t First, const uint32_t Last)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        for (uint32_t i = First; i < Last; ++i)
+        {
+            const double  lon    = Lon_Arr[i];
+            const double  lat    = std::fabs(Lat_Arr[i]) > Web_Mercator_Max_Lat ? std::copysign(Web_Mercator_Max_Lat, Lat_Arr[i]) : Lat_Arr[i]; // poles are on the edges
+            const bool    valid  = std::fabs(lon) <= 180.0 && std::fabs(Lat_Arr[i]) <= 90.0; // false for NaN
+
+            X_Arr[i]  = valid ? Web_Mercator_Radius * lon * (Pi / 180.0) : nan;
+            Y_Arr[i]  = valid ? Web_Mercator_Radius * std::log(std::tan(Pi / 4.0 + lat * (Pi / 360.0))) : nan;
+        }
+    });
+}
+
+// Convert Web Mercator coordinates to geographic ones
+void NS_Clustering::Unproject_Web_Mercator(
+    const uint32_t       ArrSize,
+    const double* const  X_Arr,
+    const double* const  Y_Arr,
+    double* const        Lon_Arr,
+    double* const        Lat_Arr,
+    const uint32_t       ThreadCount)
+{
+    TTraceScope trace_scope("Unproject_Web_Mercator");
+
+    Process_Parts(ArrSize, ThreadCount, "Unproject_Web_Mercator_Part", [X_Arr, Y_Arr, Lon_Arr, Lat_Arr](const uint32_t First, const uint32_t Last)
+    {
+        for (uint32_t i = First; i < Last; ++i)
+        {
+            Lon_Arr[i]  = X_Arr[i] / Web_Mercator_Radius * (180.0 / Pi);
+            Lat_Arr[i]  = std::atan(std::sinh(Y_Arr[i] / Web_Mercator_Radius)) * (180.0 / Pi);
+        }
+    });
+}
+
+// Load dots from arrays of coordinates and data
+uint32_t NS_Clustering::Load_Dots(
+    TMapDot&               MapDot,
+    const uint32_t         ArrSize,
+    const double* const    X_Arr,
+    const double* const    Y_Arr,
+    const uint64_t* const  Data_Arr,
+    TDotDataArena* const   Arena,
+    const uint32_t         ThreadCount)
+{
+    if (ArrSize == 0 || !X_Arr || !Y_Arr)
+        return 0;
+
+    TTraceScope trace_scope("Load_Dots");
+
+    std::vector<uint32_t> order; // indexes of the array elements in the order of coordinates and data
+
+    Collect_Finite_Coords(ArrSize, X_Arr, Y_Arr, ThreadCount, order);
+
+    const uint32_t  size      = static_cast<uint32_t>(order.size());  // number of elements with finite coordinates
+    const uint32_t  rejected  = ArrSize - size;                       // number of elements with NaN or infinite coordinates
+
+    // Sort by coordinates converted to TCoord like the keys of the set, equal coordinates - by data
+    Parallel_Sort(order, [X_Arr, Y_Arr, Data_Arr](const uint32_t A, const uint32_t B) noexcept
+    {
+        const TCoord  a_x  = To_Coord(X_Arr[A]);
+        const TCoord  b_x  = To_Coord(X_Arr[B]);
+        const TCoord  a_y  = To_Coord(Y_Arr[A]);
+        const TCoord  b_y  = To_Coord(Y_Arr[B]);
+
+        if (a_x != b_x)
+            return a_x < b_x;
+
+        if (a_y != b_y)
+            return a_y < b_y;
+
+        return Data_Arr && Data_Arr[A] < Data_Arr[B];
+    }, ThreadCount);
+
+    struct TArenaDataset // dataset of a new dot that will be placed in the arena
+    {
+        TDot*        Dot;
+        std::size_t  Offset;
+        uint32_t     Count;
+    };
+
+    std::vector<uint64_t>       values;          // unique values of the current dot; values of all new dots for the arena
+    std::vector<TArenaDataset>  arena_datasets;  // new dots whose datasets will be placed in the arena
+    auto                        hint = MapDot.begin(); // position in the set, moves only forward, since the keys are sorted
+
+    for (uint32_t i = 0; i < size;)
+    {
+        const TCoordKey    key(X_Arr[order[i]], Y_Arr[order[i]]);
+        const std::size_t  offset = Arena ? values.size() : 0;
+
+        if (!Arena)
+            values.clear();
+
+        // Collect unique data of all elements with the same coordinates
+        for (; i < size && To_Coord(X_Arr[order[i]]) == key.X && To_Coord(Y_Arr[order[i]]) == key.Y; ++i)
+        {
+            if (Data_Arr && (values.size() == offset || values.back() != Data_Arr[order[i]]))
+                values.push_back(Data_Arr[order[i]]);
+        }
+
+        const uint32_t count = static_cast<uint32_t>(values.size() - offset);
+
+        while (hint != MapDot.end() && hint->first < key) // skip existing dots with smaller coordinates
+            ++hint;
+
+        if (hint != MapDot.end() && hint->first == key) // dot already exists, add data to it
+        {
+            for (uint32_t j = 0; j < count; ++j)
+                hint->second->SetData.insert(values[offset + j]);
+
+            if (Arena)
+                values.resize(offset);
+        }
+        else // create a new dot before the hint
+        {
+            TDot* const dot = new TDot(key.X, key.Y);
+
+            hint = MapDot.emplace_hint(hint, key, dot);
+
+            if (Arena && count > 1)
+                arena_datasets.push_back({ dot, offset, count });
+            else
+            {
+                dot->SetData.Assign(values.data() + offset, values.data() + offset + count);
+
+                if (Arena)
+                    values.resize(offset);
+            }
+        }
+    }
+
+    if (!arena_datasets.empty()) // place the datasets of new dots in one block of the arena
+    {
+        uint64_t* const block = Arena->Allocate(values.size());
+
+        std::copy(values.cbegin(), values.cend(), block);
+
+        for (const auto& dataset : arena_datasets)
+            dataset.Dot->SetData.Refer(block + dataset.Offset, dataset.Count);
+    }
+
+    return rejected;
+}
+
 // Create set of clusters_1
 void NS_Clustering::Create_Clusters_1(
     TMapDot&        MapDot,
     TMapCluster_1&  MapCluster_1,
     const bool      SingleDot_To_Cluster_1)
 {
+    TTraceScope trace_scope("Create_Clusters_1");
+
     std::list<TCluster_1*>  list_cluster_1;            // temporary list of clusters_1
     std::list<TDot*>        list_dot_without_cluster;  // dots without cluster
     bool                    merged = true;             // clustering elements was merged
     bool                    dot_i_removed;             // i-th dot from set_dot_without_cluster was removed (cit_dwc_i)
     bool                    c1_deleted;                // cluster_1 was absorbed by another cluster_1
 
-    for (auto& dot : MapDot) // collect dot addresses, assuming that none of them are in any cluster
+    for (auto& dot : MapDot) // collect addresses of selected dots, assuming that none of them are in any cluster
     {
         dot.second->InCluster = false;
-        list_dot_without_cluster.push_back(dot.second);
+        dot.second->Parent    = nullptr;
+
+        if (dot.second->Selected)
+            list_dot_without_cluster.push_back(dot.second);
     }
 
     while (merged) // merge into clusters_1, while at least something is merged
     {
         merged = false;
+        SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+        TTraceScope  trace_pass("Merge_Pass");          // the whole pass
+        TTraceScope  trace_search("Candidate_Search");  // search of pairs of elements for new clusters
 
         // Pass through all dots without any cluster
         for (auto cit_dwc_i = list_dot_without_cluster.cbegin(), cend_dwc = list_dot_without_cluster.cend(); cit_dwc_i != cend_dwc;)
@@ -836,6 +2038,10 @@ void NS_Clustering::Create_Clusters_1(
                 ++cit_dwc_i; // go to the next i-th dot
         }
 
+        trace_search.Stop();
+
+        TTraceScope trace_add("Add_To_Clusters");
+
         // Add dots to clusters_1, if possible
         for (auto c1 : list_cluster_1) // pass through all clusters_1
         {
@@ -853,6 +2059,10 @@ void NS_Clustering::Create_Clusters_1(
             }
         }
 
+        trace_add.Stop();
+
+        TTraceScope trace_merge("Merge_Clusters");
+
         // Merge clusters_1, if possible
         for (auto it_c1_i = list_cluster_1.begin(), end_c1 = list_cluster_1.end(); it_c1_i != end_c1;) // pass through all clusters_1
         {
@@ -877,6 +2087,8 @@ void NS_Clustering::Create_Clusters_1(
         }
     }
 
+    TTraceScope trace_single("Single_Elements");
+
     if (SingleDot_To_Cluster_1) // need to turn the remaining single dot into clusters_1
     {
         for (const auto dot : list_dot_without_cluster) // make cluster_1 from each dot and add it to the list
@@ -885,6 +2097,7 @@ void NS_Clustering::Create_Clusters_1(
         do // merge into clusters_1, while at least something is merged
         {
             merged = false;
+            SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
 
             // Merge clusters_1, if possible
             for (auto it_c1_i = list_cluster_1.begin(), end_c1 = list_cluster_1.end(); it_c1_i != end_c1;) // pass through all clusters_1
@@ -912,12 +2125,16 @@ void NS_Clustering::Create_Clusters_1(
         while (merged);
     }
 
+    trace_single.Stop();
+
+    TTraceScope trace_collect("Collect_Clusters");
+
     // When merging clusters_1 and adding dots to them, their centers no longer match the key in the set, need to recreate the set
     Clear_Map_Of_ClusteringElem(MapCluster_1); // clear the set of clusters_1
 
     // Move clusters_1 from the temporary list to the required
     for (const auto c1 : list_cluster_1)
-        MapCluster_1.emplace(TCoordKey(c1->X, c1->Y), c1);
+        Emplace_Cluster(MapCluster_1, c1, &TCluster_1::Eat_Cluster_1);
 }
 
 // Create set of clusters_2
@@ -927,27 +2144,34 @@ void NS_Clustering::Create_Clusters_2(
     TMapCluster_2&  MapCluster_2,
     const bool      SingleClusteringElem_To_Cluster_2)
 {
+    TTraceScope trace_scope("Create_Clusters_2");
+
     std::list<TCluster_2*>       list_cluster_2;             // temporary list of clusters_2
     std::list<TClusteringElem*>  list_elem_without_cluster;  // clustering elements without cluster
     bool                         merged = true;              // clustering elements was merged
     bool                         elem_i_removed;             // i-th element from set_elem_without_cluster was removed (cit_ewc_i)
     bool                         c2_deleted;                 // cluster_2 was absorbed by another cluster_2
 
-    for (const auto& dot : MapDot) // collect dot addresses that are not in any cluster
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
     {
-        if (!dot.second->InCluster)
+        if (!dot.second->InCluster && dot.second->Selected)
             list_elem_without_cluster.push_back(dot.second);
     }
 
     for (auto& c1 : MapCluster_1) // collect cluster_1 addresses, assuming that none of them are in any cluster
     {
         c1.second->InCluster = false;
+        c1.second->Parent    = nullptr;
         list_elem_without_cluster.push_back(c1.second);
     }
 
     while (merged) // merge into clusters_2, while at least something is merged
     {
         merged = false;
+        SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+        TTraceScope  trace_pass("Merge_Pass");          // the whole pass
+        TTraceScope  trace_search("Candidate_Search");  // search of pairs of elements for new clusters
 
         // Pass through all clustering elements without any cluster
         for (auto cit_ewc_i = list_elem_without_cluster.cbegin(), cend_ewc = list_elem_without_cluster.cend(); cit_ewc_i != cend_ewc;)
@@ -993,6 +2217,10 @@ void NS_Clustering::Create_Clusters_2(
                 ++cit_ewc_i; // go to the next i-th element
         }
 
+        trace_search.Stop();
+
+        TTraceScope trace_add("Add_To_Clusters");
+
         // Add elements to clusters_2, if possible
         for (auto c2 : list_cluster_2) // pass through all clusters_2
         {
@@ -1010,6 +2238,10 @@ void NS_Clustering::Create_Clusters_2(
             }
         }
 
+        trace_add.Stop();
+
+        TTraceScope trace_merge("Merge_Clusters");
+
         // Merge clusters_2, if possible
         for (auto it_c2_i = list_cluster_2.begin(), end_c2 = list_cluster_2.end(); it_c2_i != end_c2;) // pass through all clusters_2
         {
@@ -1034,6 +2266,8 @@ void NS_Clustering::Create_Clusters_2(
         }
     }
 
+    TTraceScope trace_single("Single_Elements");
+
     if (SingleClusteringElem_To_Cluster_2) // need to turn the remaining single clustering elements into clusters_2
     {
         for (const auto elem : list_elem_without_cluster) // make cluster_2 from each element and add it to the list
@@ -1042,6 +2276,7 @@ void NS_Clustering::Create_Clusters_2(
         do // merge into clusters_2, while at least something is merged
         {
             merged = false;
+            SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
 
             // Merge clusters_2, if possible
             for (auto it_c2_i = list_cluster_2.begin(), end_c2 = list_cluster_2.end(); it_c2_i != end_c2;) // pass through all clusters_2
@@ -1069,12 +2304,16 @@ void NS_Clustering::Create_Clusters_2(
         while (merged);
     }
 
+    trace_single.Stop();
+
+    TTraceScope trace_collect("Collect_Clusters");
+
     // When merging clusters_2 and adding elements to them, their centers no longer match the key in the set, need to recreate the set
     Clear_Map_Of_ClusteringElem(MapCluster_2); // clear the set of clusters_2
 
     // Move clusters_2 from the temporary list to the required
     for (const auto c2 : list_cluster_2)
-        MapCluster_2.emplace(TCoordKey(c2->X, c2->Y), c2);
+        Emplace_Cluster(MapCluster_2, c2, &TCluster_2::Eat_Cluster_2);
 }
 
 // Create set of clusters_3
@@ -1085,15 +2324,17 @@ void NS_Clustering::Create_Clusters_3(
     TMapCluster_3&  MapCluster_3,
     const bool      SingleClusteringElem_To_Cluster_3)
 {
+    TTraceScope trace_scope("Create_Clusters_3");
+
     std::list<TCluster_3*>       list_cluster_3;             // temporary list of clusters_3
     std::list<TClusteringElem*>  list_elem_without_cluster;  // clustering elements without cluster
     bool                         merged = true;              // clustering elements was merged
     bool                         elem_i_removed;             // i-th element from set_elem_without_cluster was removed (cit_ewc_i)
     bool                         c3_deleted;                 // cluster_3 was absorbed by another cluster_3
 
-    for (const auto& dot : MapDot) // collect dot addresses that are not in any cluster
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
     {
-        if (!dot.second->InCluster)
+        if (!dot.second->InCluster && dot.second->Selected)
             list_elem_without_cluster.push_back(dot.second);
     }
 
@@ -1106,12 +2347,17 @@ void NS_Clustering::Create_Clusters_3(
     for (auto& c2 : MapCluster_2) // collect cluster_2 addresses, assuming that none of them are in any cluster
     {
         c2.second->InCluster = false;
+        c2.second->Parent    = nullptr;
         list_elem_without_cluster.push_back(c2.second);
     }
 
     while (merged) // merge into clusters_3, while at least something is merged
     {
         merged = false;
+        SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+        TTraceScope  trace_pass("Merge_Pass");          // the whole pass
+        TTraceScope  trace_search("Candidate_Search");  // search of pairs of elements for new clusters
 
         // Pass through all clustering elements without any cluster
         for (auto cit_ewc_i = list_elem_without_cluster.cbegin(), cend_ewc = list_elem_without_cluster.cend(); cit_ewc_i != cend_ewc;)
@@ -1157,6 +2403,10 @@ void NS_Clustering::Create_Clusters_3(
                 ++cit_ewc_i; // go to the next i-th element
         }
 
+        trace_search.Stop();
+
+        TTraceScope trace_add("Add_To_Clusters");
+
         // Add elements to clusters_3, if possible
         for (auto c3 : list_cluster_3) // pass through all clusters_3
         {
@@ -1174,6 +2424,10 @@ void NS_Clustering::Create_Clusters_3(
             }
         }
 
+        trace_add.Stop();
+
+        TTraceScope trace_merge("Merge_Clusters");
+
         // Merge clusters_3, if possible
         for (auto it_c3_i = list_cluster_3.begin(), end_c3 = list_cluster_3.end(); it_c3_i != end_c3;) // pass through all clusters_3
         {
@@ -1198,6 +2452,8 @@ void NS_Clustering::Create_Clusters_3(
         }
     }
 
+    TTraceScope trace_single("Single_Elements");
+
     if (SingleClusteringElem_To_Cluster_3) // need to turn the remaining single clustering elements into clusters_3
     {
         for (const auto elem : list_elem_without_cluster) // make cluster_3 from each element and add it to the list
@@ -1206,6 +2462,7 @@ void NS_Clustering::Create_Clusters_3(
         do // merge into clusters_3, while at least something is merged
         {
             merged = false;
+            SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
 
             // Merge clusters_3, if possible
             for (auto it_c3_i = list_cluster_3.begin(), end_c3 = list_cluster_3.end(); it_c3_i != end_c3;) // pass through all clusters_3
@@ -1233,12 +2490,16 @@ void NS_Clustering::Create_Clusters_3(
         while (merged);
     }
 
+    trace_single.Stop();
+
+    TTraceScope trace_collect("Collect_Clusters");
+
     // When merging clusters_3 and adding elements to them, their centers no longer match the key in the set, need to recreate the set
     Clear_Map_Of_ClusteringElem(MapCluster_3); // clear the set of clusters_3
 
     // Move clusters_3 from the temporary list to the required
     for (const auto c3 : list_cluster_3)
-        MapCluster_3.emplace(TCoordKey(c3->X, c3->Y), c3);
+        Emplace_Cluster(MapCluster_3, c3, &TCluster_3::Eat_Cluster_3);
 }
 
 // Create set of clusters_4
@@ -1250,15 +2511,17 @@ void NS_Clustering::Create_Clusters_4(
     TMapCluster_4&  MapCluster_4,
     const bool      SingleClusteringElem_To_Cluster_4)
 {
+    TTraceScope trace_scope("Create_Clusters_4");
+
     std::list<TCluster_4*>       list_cluster_4;             // temporary list of clusters_4
     std::list<TClusteringElem*>  list_elem_without_cluster;  // clustering elements without cluster
     bool                         merged = true;              // clustering elements was merged
     bool                         elem_i_removed;             // i-th element from set_elem_without_cluster was removed (cit_ewc_i)
     bool                         c4_deleted;                 // cluster_4 was absorbed by another cluster_4
 
-    for (const auto& dot : MapDot) // collect dot addresses that are not in any cluster
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
     {
-        if (!dot.second->InCluster)
+        if (!dot.second->InCluster && dot.second->Selected)
             list_elem_without_cluster.push_back(dot.second);
     }
 
@@ -1277,12 +2540,17 @@ void NS_Clustering::Create_Clusters_4(
     for (auto& c3 : MapCluster_3) // collect cluster_3 addresses, assuming that none of them are in any cluster
     {
         c3.second->InCluster = false;
+        c3.second->Parent    = nullptr;
         list_elem_without_cluster.push_back(c3.second);
     }
 
     while (merged) // merge into clusters_4, while at least something is merged
     {
         merged = false;
+        SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
+
+        TTraceScope  trace_pass("Merge_Pass");          // the whole pass
+        TTraceScope  trace_search("Candidate_Search");  // search of pairs of elements for new clusters
 
         // Pass through all clustering elements without any cluster
         for (auto cit_ewc_i = list_elem_without_cluster.cbegin(), cend_ewc = list_elem_without_cluster.cend(); cit_ewc_i != cend_ewc;)
@@ -1328,6 +2596,10 @@ void NS_Clustering::Create_Clusters_4(
                 ++cit_ewc_i; // go to the next i-th element
         }
 
+        trace_search.Stop();
+
+        TTraceScope trace_add("Add_To_Clusters");
+
         // Add elements to clusters_4, if possible
         for (auto c4 : list_cluster_4) // pass through all clusters_4
         {
@@ -1345,6 +2617,10 @@ void NS_Clustering::Create_Clusters_4(
             }
         }
 
+        trace_add.Stop();
+
+        TTraceScope trace_merge("Merge_Clusters");
+
         // Merge clusters_4, if possible
         for (auto it_c4_i = list_cluster_4.begin(), end_c4 = list_cluster_4.end(); it_c4_i != end_c4;) // pass through all clusters_4
         {
@@ -1369,6 +2645,8 @@ void NS_Clustering::Create_Clusters_4(
         }
     }
 
+    TTraceScope trace_single("Single_Elements");
+
     if (SingleClusteringElem_To_Cluster_4) // need to turn the remaining single clustering elements into clusters_4
     {
         for (const auto elem : list_elem_without_cluster) // make cluster_4 from each element and add it to the list
@@ -1377,6 +2655,7 @@ void NS_Clustering::Create_Clusters_4(
         do // merge into clusters_4, while at least something is merged
         {
             merged = false;
+            SIMPLE_CLUSTERING_COUNT(Merge_Pass_Count);
 
             // Merge clusters_4, if possible
             for (auto it_c4_i = list_cluster_4.begin(), end_c4 = list_cluster_4.end(); it_c4_i != end_c4;) // pass through all clusters_4
@@ -1404,10 +2683,148 @@ void NS_Clustering::Create_Clusters_4(
         while (merged);
     }
 
+    trace_single.Stop();
+
+    TTraceScope trace_collect("Collect_Clusters");
+
     // When merging clusters_4 and adding elements to them, their centers no longer match the key in the set, need to recreate the set
     Clear_Map_Of_ClusteringElem(MapCluster_4); // clear the set of clusters_4
 
     // Move clusters_4 from the temporary list to the required
     for (const auto c4 : list_cluster_4)
-        MapCluster_4.emplace(TCoordKey(c4->X, c4->Y), c4);
+        Emplace_Cluster(MapCluster_4, c4, &TCluster_4::Eat_Cluster_4);
+}
+
+// Create set of clusters_1 by the grid
+void NS_Clustering::Create_Grid_Clusters_1(
+    TMapDot&        MapDot,
+    TMapCluster_1&  MapCluster_1,
+    const bool      SingleDot_To_Cluster_1,
+    const bool      Merge_Neighbors)
+{
+    TTraceScope trace_scope("Create_Grid_Clusters_1");
+
+    std::vector<TDot*> vec_dot; // dots to be clustered
+
+    vec_dot.reserve(MapDot.size());
+
+    for (auto& dot : MapDot) // collect addresses of selected dots, assuming that none of them are in any cluster
+    {
+        dot.second->InCluster = false;
+        dot.second->Parent    = nullptr;
+
+        if (dot.second->Selected)
+            vec_dot.push_back(dot.second);
+    }
+
+    Create_Grid_Clusters(vec_dot, MapCluster_1, Cluster_1_Radius, SingleDot_To_Cluster_1, Merge_Neighbors,
+        &TCluster_1::Add_Dot, &TCluster_1::Check_Cluster_1, &TCluster_1::Eat_Cluster_1);
+}
+
+// Create set of clusters_2 by the grid
+void NS_Clustering::Create_Grid_Clusters_2(
+    TMapDot&        MapDot,
+    TMapCluster_1&  MapCluster_1,
+    TMapCluster_2&  MapCluster_2,
+    const bool      SingleClusteringElem_To_Cluster_2,
+    const bool      Merge_Neighbors)
+{
+    TTraceScope trace_scope("Create_Grid_Clusters_2");
+
+    std::vector<TClusteringElem*> vec_elem; // clustering elements to be clustered
+
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
+    {
+        if (!dot.second->InCluster && dot.second->Selected)
+            vec_elem.push_back(dot.second);
+    }
+
+    for (auto& c1 : MapCluster_1) // collect cluster_1 addresses, assuming that none of them are in any cluster
+    {
+        c1.second->InCluster = false;
+        c1.second->Parent    = nullptr;
+        vec_elem.push_back(c1.second);
+    }
+
+    Create_Grid_Clusters(vec_elem, MapCluster_2, Cluster_2_Radius, SingleClusteringElem_To_Cluster_2, Merge_Neighbors,
+        &TCluster_2::Add_ClusteringElem, &TCluster_2::Check_Cluster_2, &TCluster_2::Eat_Cluster_2);
+}
+
+// Create set of clusters_3 by the grid
+void NS_Clustering::Create_Grid_Clusters_3(
+    TMapDot&        MapDot,
+    TMapCluster_1&  MapCluster_1,
+    TMapCluster_2&  MapCluster_2,
+    TMapCluster_3&  MapCluster_3,
+    const bool      SingleClusteringElem_To_Cluster_3,
+    const bool      Merge_Neighbors)
+{
+    TTraceScope trace_scope("Create_Grid_Clusters_3");
+
+    std::vector<TClusteringElem*> vec_elem; // clustering elements to be clustered
+
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
+    {
+        if (!dot.second->InCluster && dot.second->Selected)
+            vec_elem.push_back(dot.second);
+    }
+
+    for (const auto& c1 : MapCluster_1) // collect cluster_1 addresses that are not in any cluster
+    {
+        if (!c1.second->InCluster)
+            vec_elem.push_back(c1.second);
+    }
+
+    for (auto& c2 : MapCluster_2) // collect cluster_2 addresses, assuming that none of them are in any cluster
+    {
+        c2.second->InCluster = false;
+        c2.second->Parent    = nullptr;
+        vec_elem.push_back(c2.second);
+    }
+
+    Create_Grid_Clusters(vec_elem, MapCluster_3, Cluster_3_Radius, SingleClusteringElem_To_Cluster_3, Merge_Neighbors,
+        &TCluster_3::Add_ClusteringElem, &TCluster_3::Check_Cluster_3, &TCluster_3::Eat_Cluster_3);
+}
+
+// Create set of clusters_4 by the grid
+void NS_Clustering::Create_Grid_Clusters_4(
+    TMapDot&        MapDot,
+    TMapCluster_1&  MapCluster_1,
+    TMapCluster_2&  MapCluster_2,
+    TMapCluster_3&  MapCluster_3,
+    TMapCluster_4&  MapCluster_4,
+    const bool      SingleClusteringElem_To_Cluster_4,
+    const bool      Merge_Neighbors)
+{
+    TTraceScope trace_scope("Create_Grid_Clusters_4");
+
+    std::vector<TClusteringElem*> vec_elem; // clustering elements to be clustered
+
+    for (const auto& dot : MapDot) // collect addresses of selected dots that are not in any cluster
+    {
+        if (!dot.second->InCluster && dot.second->Selected)
+            vec_elem.push_back(dot.second);
+    }
+
+    for (const auto& c1 : MapCluster_1) // collect cluster_1 addresses that are not in any cluster
+    {
+        if (!c1.second->InCluster)
+            vec_elem.push_back(c1.second);
+    }
+
+    for (const auto& c2 : MapCluster_2) // collect cluster_2 addresses that are not in any cluster
+    {
+        if (!c2.second->InCluster)
+            vec_elem.push_back(c2.second);
+    }
+
+    for (auto& c3 : MapCluster_3) // collect cluster_3 addresses, assuming that none of them are in any cluster
+    {
+        c3.second->InCluster = false;
+        c3.second->Parent    = nullptr;
+        vec_elem.push_back(c3.second);
+    }
+
+    Create_Grid_Clusters(vec_elem, MapCluster_4, Cluster_4_Radius, SingleClusteringElem_To_Cluster_4, Merge_Neighbors,
+        &TCluster_4::Add_ClusteringElem, &TCluster_4::Check_Cluster_4, &TCluster_4::Eat_Cluster_4);
 }
@@ -15,7 +15,15 @@
 
 #include <set>
 #include <map>
-
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <cmath>
 #include <cstdint>
 
 namespace NS_Clustering
@@ -28,26 +36,171 @@ namespace NS_Clustering
     static const uint16_t  ID_CLUSTER_3   = 3;
     static const uint16_t  ID_CLUSTER_4   = 4;
 
-    extern double  Dot_Radius;
-    extern double  Cluster_1_Radius;
-    extern double  Cluster_2_Radius;
-    extern double  Cluster_3_Radius;
-    extern double  Cluster_4_Radius;
+    // Index of the clustering element that is not in the dense array of its level
+    static const uint32_t INDEX_NONE = 0xFFFFFFFF;
+
+    /* Service memory of nodes of containers besides their values, as in the common implementations of the standard library: a
+    node of a tree has the color and 3 links, a node of a hash table has the link and the cached hash. */
+    static const std::size_t  Map_Node_Overhead   = sizeof(void*) * 4;
+    static const std::size_t  Hash_Node_Overhead  = sizeof(void*) * 2;
+
+    /* Type of coordinates and radii of clustering elements. With SIMPLE_CLUSTERING_FLOAT_COORD it is float: coordinates take half of
+    the memory, which is enough for screen and tile coordinates. With SIMPLE_CLUSTERING_INT_COORD it is int32_t: coordinates are
+    quantized to the integer grid whose step is the unit of the passed coordinates (for example, degrees multiplied by 1e7 or
+    centimeters), so keys are compared exactly and distances are checked in integers. Coordinates are passed to the constructors as
+    double and are converted by To_Coord, so the interface does not depend on the type. */
+    #if defined(SIMPLE_CLUSTERING_FLOAT_COORD)
+      using TCoord = float;
+    #elif defined(SIMPLE_CLUSTERING_INT_COORD)
+      using TCoord = int32_t;
+    #else
+      using TCoord = double;
+    #endif
+
+    // Limit of the absolute value of integer coordinates (the range of int32_t)
+    static const double Int_Coord_Limit = 2147483647.0;
+
+    // Convert the passed coordinate to TCoord (integer coordinates are rounded to the nearest node of the grid)
+    inline TCoord To_Coord(const double Value) noexcept
+    {
+        #if defined(SIMPLE_CLUSTERING_INT_COORD)
+          return static_cast<TCoord>(std::llround(Value));
+        #else
+          return static_cast<TCoord>(Value);
+        #endif
+    }
+
+    // Check if the passed coordinate is finite and in the range of TCoord
+    inline bool Coord_Is_Valid(const double Value) noexcept
+    {
+        #if defined(SIMPLE_CLUSTERING_INT_COORD)
+          return std::fabs(Value) < Int_Coord_Limit; // false for NaN
+        #else
+          return std::isfinite(static_cast<TCoord>(Value));
+        #endif
+    }
+
+    extern TCoord  Dot_Radius;
+    extern TCoord  Cluster_1_Radius;
+    extern TCoord  Cluster_2_Radius;
+    extern TCoord  Cluster_3_Radius;
+    extern TCoord  Cluster_4_Radius;
 
     /* An additional part of the radius - is added to the radius of the clustering object when checking the possibility of merging.
     It may be necessary when graphically displaying clustering elements so that it does not seem that the center of any element
     located on the edge of another element. */
-    extern double AdditionalRadiusValue;
+    extern TCoord AdditionalRadiusValue;
 
     // Whether to use the additional part of the radius when checking the possibility of merging clustering objects
     extern int16_t Use_AdditionalRadiusValue;
 
+    struct TStats // instrumentation counters of a phase of clustering, they are counted only if SIMPLE_CLUSTERING_STATS is defined
+    {
+        uint64_t  Coord_In_Circle_Count;  // evaluations of Coord_In_Circle
+        uint64_t  Merge_Pass_Count;       // passes of merging loops (while something is merged)
+        uint64_t  Merge_Count;            // merges of clustering elements into clusters and of clusters with each other
+        uint64_t  Set_Center_Count;       // calculations of centers of clusters
+        uint64_t  Allocation_Count;       // created clustering elements
+        uint64_t  Nanoseconds;            // wall time of the phase
+    };
+
+    #if defined(SIMPLE_CLUSTERING_STATS)
+      extern thread_local TStats* Current_Stats; // counters of the phase running in this thread (nullptr - nothing is counted)
+
+      // Counters of Current_Stats are reset and counted while the scope exists, then its wall time is stored
+      class TStatsScope
+      {
+      private:
+          TStats*   Previous;  // counters of the enclosing scope
+          TStats&   Stats;
+          uint64_t  Start;     // time of the beginning of the scope
+
+      public:
+          explicit TStatsScope(TStats& Stats_) noexcept;
+          TStatsScope(const TStatsScope&) = delete;
+          TStatsScope& operator = (const TStatsScope&) = delete;
+          ~TStatsScope(void) noexcept;
+      };
+
+      #define SIMPLE_CLUSTERING_COUNT(Counter) do { if (NS_Clustering::Current_Stats) ++NS_Clustering::Current_Stats->Counter; } while (false)
+    #else
+      #define SIMPLE_CLUSTERING_COUNT(Counter) do {} while (false)
+    #endif
+
+    /* Timeline of clustering: events are written in the Chrome Trace Event format, which is opened by Perfetto and
+    chrome://tracing. Events are recorded by TTraceScope in the trace current for the thread, so tracing costs nothing when
+    there is no current trace. */
+    class TTrace
+    {
+    private:
+        struct TEvent
+        {
+            const char*  Name;      // name of the event (string literal)
+            uint32_t     Thread;    // number of the thread
+            uint64_t     Start;     // nanoseconds from the creation of the trace
+            uint64_t     Duration;  // nanoseconds
+        };
+
+        const std::chrono::steady_clock::time_point  Created;  // beginning of the timeline
+        mutable std::mutex                           Mutex;    // events are added from several threads
+        std::vector<TEvent>                          Events;
+        std::vector<std::thread::id>                 Threads;  // threads of events by their numbers
+
+        // Get the number of the thread, a new thread gets the next number (Mutex must be locked)
+        uint32_t Get_Thread_Number(const std::thread::id Id);
+
+    public:
+        TTrace(void) noexcept;
+        TTrace(const TTrace&) = delete;
+        TTrace& operator = (const TTrace&) = delete;
+
+        // Get the time from the beginning of the timeline in nanoseconds
+        uint64_t Get_Time(void) const noexcept;
+
+        /* Number the current thread if it has no number yet. Threads are numbered when they make the trace current, so the thread
+        of the call that starts the work is 0 before any of its working threads ends an event. */
+        void Add_Thread(void);
+
+        // Add the event of the current thread
+        void Add(const char* const Name, const uint64_t Start, const uint64_t End);
+
+        // Write events to the JSON file (false - the file cannot be written)
+        bool Write(const char* const FileName) const;
+    };
+
+    extern thread_local TTrace* Current_Trace; // trace of the thread (nullptr - events are not recorded)
+
+    class TTraceScope // event of the timeline from the creation of the scope to its end
+    {
+    private:
+        TTrace*      Trace;     // trace of the event (nullptr - the event is not recorded)
+        TTrace*      Previous;  // trace current for the thread before the scope
+        const bool   Attached;  // the trace is made current for the thread
+        const char*  Name;
+        uint64_t     Start;
+
+    public:
+        // Record the event in the current trace of the thread
+        explicit TTraceScope(const char* const Name_) noexcept;
+
+        /* Make the trace current for the thread until the end of the scope and record the event in it (for working threads). If
+        the trace is nullptr (it is not started), nothing is recorded. */
+        TTraceScope(TTrace* const Trace_, const char* const Name_) noexcept;
+
+        TTraceScope(const TTraceScope&) = delete;
+        TTraceScope& operator = (const TTraceScope&) = delete;
+        ~TTraceScope(void) noexcept;
+
+        // End the event before the end of the scope
+        void Stop(void) noexcept;
+    };
+
 
     class TCoordKey // coordinate key for containers
     {
     public:
-        double  X;
-        double  Y;
+        TCoord  X;
+        TCoord  Y;
 
 
         TCoordKey(void) noexcept;
@@ -56,6 +209,14 @@ namespace NS_Clustering
         bool operator == (const TCoordKey& Obj) const noexcept;
         bool operator != (const TCoordKey& Obj) const noexcept;
         bool operator < (const TCoordKey& Obj) const noexcept;
+
+        #if defined(SIMPLE_CLUSTERING_INT_COORD)
+          // Coordinates packed into one word in the order of keys (signs are flipped, so the unsigned order matches the signed one)
+          uint64_t Get_Packed(void) const noexcept
+          {
+              return (static_cast<uint64_t>(static_cast<uint32_t>(X) ^ 0x80000000U) << 32) | (static_cast<uint32_t>(Y) ^ 0x80000000U);
+          }
+        #endif
     };
 
     class TClusteringElem // base class for all classes of clustering elements
@@ -64,12 +225,20 @@ namespace NS_Clustering
         uint16_t ClusteringElem_Id; // unique identifier for classes of clustering elements
 
     public:
-        double    X;
-        double    Y;
-        double    R;          // radius
+        TCoord    X;
+        TCoord    Y;
+        TCoord    R;          // radius
         bool      InCluster;  // whether the item is in any cluster
+        bool      Selected;   // whether the item takes part in clustering (dots out of the selection of the clusterizator are skipped)
         uint64_t  Tag;        // label (variable for any user data, for example, the address of any data)
 
+        mutable const TClusteringElem* Parent; // cluster that contains the element (nullptr - not in any cluster)
+
+        /* Index of the element in the dense array of its level (INDEX_NONE - not indexed). The index of a dot does not change
+        until the dots are cleared or a dot expires (the last dot takes its index), the index of a cluster does not change until
+        its level is recreated or a cluster of the level is deleted on expiry of dots (the last cluster takes its index). */
+        uint32_t Index;
+
 
         TClusteringElem(void) noexcept;
         explicit TClusteringElem(const uint16_t ClusteringElem_Id_) noexcept;
@@ -83,10 +252,108 @@ namespace NS_Clustering
         void Set_Tag_If_Empty(const uint64_t Tag_) noexcept;
     };
 
+    class TDotData;
+
+    /* Shared storage of datasets of dots, each block is one contiguous array of datasets. Values of datasets that are changed (they
+    get own buffers) stay in the blocks until the arena is compacted or cleared. */
+    class TDotDataArena
+    {
+    private:
+        struct TBlock
+        {
+            std::unique_ptr<uint64_t[]>  Values;
+            std::size_t                  Count;
+        };
+
+        std::vector<TBlock>  Blocks;     // allocated blocks
+        std::size_t          Size;       // total number of values in all blocks
+        std::size_t          Base_Size;  // size after the last compaction or the first load (0 - not loaded yet)
+
+    public:
+        TDotDataArena(void) noexcept;
+        TDotDataArena(const TDotDataArena&) = delete;
+        TDotDataArena& operator = (const TDotDataArena&) = delete;
+
+        // Allocate a contiguous block for the specified number of values
+        uint64_t* Allocate(const std::size_t Count);
+
+        // Get the total number of values in all blocks
+        std::size_t Get_Size(void) const noexcept;
+
+        // Get the memory of blocks in bytes
+        std::size_t Get_Memory_Usage(void) const noexcept;
+
+        // Note the end of loading of dots, true - the arena has doubled since the last compaction or the first load
+        bool Note_Load(void) noexcept;
+
+        /* Move the values of datasets that refer to the arena into one new block and free the old blocks, so values of changed
+        or deleted datasets are reclaimed. VecData must contain all datasets that refer to the arena, datasets that refer to
+        other storage are not moved. Returns the number of freed values. */
+        std::size_t Compact(const std::vector<TDotData*>& VecData);
+
+        // Free all blocks (datasets of dots that refer to the arena must be deleted before)
+        void Clear(void) noexcept;
+    };
+
+    /* Dataset for dot: sorted unique values. A single value is stored inside the object without allocation, several values
+    are stored in own buffer or in a block of TDotDataArena (in this case the buffer is created on the first change). */
+    class TDotData
+    {
+    private:
+        union
+        {
+            uint64_t   Value;  // single value
+            uint64_t*  Arr;    // several values
+        };
+
+        uint32_t  Size;      // number of values
+        uint32_t  Capacity;  // capacity of own buffer (0 - there is no own buffer)
+
+        // Get the address of the values for change, own buffer is created if there is not enough space in it
+        uint64_t* Reserve(const uint32_t Count);
+
+    public:
+        TDotData(void) noexcept;
+        TDotData(const TDotData& Obj);
+        ~TDotData(void) noexcept;
+
+        TDotData& operator = (const TDotData& Obj);
+
+        // Get the number of values
+        std::size_t size(void) const noexcept;
+
+        // Check for absence of values
+        bool empty(void) const noexcept;
+
+        // Get the sorted values
+        const uint64_t* begin(void) const noexcept;
+        const uint64_t* end(void) const noexcept;
+        const uint64_t* cbegin(void) const noexcept;
+        const uint64_t* cend(void) const noexcept;
+
+        // Add value, if there is no such value yet (true - added)
+        bool insert(const uint64_t Data);
+
+        // Set sorted unique values
+        void Assign(const uint64_t* const First, const uint64_t* const Last);
+
+        // Refer to sorted unique values stored outside the object (for example, in TDotDataArena), which must live longer than the dataset
+        void Refer(const uint64_t* const First, const uint32_t Count);
+
+        // Whether the values are stored outside the object (Refer)
+        bool Is_Referred(void) const noexcept;
+
+        // Remove all values
+        void clear(void) noexcept;
+
+        // Get the memory of own buffer in bytes (values inside the object or outside of it are not counted)
+        std::size_t Get_Memory_Usage(void) const noexcept;
+    };
+
     class TDot : public TClusteringElem
     {
     public:
-        std::set<uint64_t> SetData; // dataset for dot (for example, the addresses of any data)
+        TDotData SetData; // dataset for dot (for example, the addresses of any data)
 
 
         TDot(void) noexcept;
@@ -96,18 +363,34 @@ namespace NS_Clustering
         // Get the amount of data
         std::size_t Get_Count(void) const noexcept;
 
+        // Get the number of dots
+        std::size_t Get_Dot_Count(void) const noexcept;
+
         // Get data for all dots
         std::set<uint64_t> Get_Data(void) const noexcept;
+
+        // Get the memory of the dataset outside the object in bytes
+        std::size_t Get_Member_Memory_Usage(void) const noexcept;
+
+        // Visit the dot itself (for uniformity with clusters), Visit returns false to stop visiting
+        template <typename Visitor> bool For_Each_Dot(Visitor&& Visit) const
+        {
+            return Visit(static_cast<const TDot*>(this));
+        }
     };
 
     using TMapDot   = std::map<TCoordKey, TDot*>;
     using TMapCDot  = std::map<TCoordKey, const TDot*>;
+    using TVecDot   = std::vector<TDot*>;
 
     class TCluster_1 : public TClusteringElem
     {
     public:
         TMapCDot MapDot; // dots
 
+        std::size_t  DataCount;  // amount of data of all dots (is counted when elements are added)
+        std::size_t  DotCount;   // number of all dots (is counted when elements are added)
+
 
         TCluster_1(void) noexcept;
         explicit TCluster_1(TDot* const Dot) noexcept;
@@ -119,24 +402,43 @@ namespace NS_Clustering
         // Get the amount of data
         std::size_t Get_Count(void) const noexcept;
 
+        // Get the number of dots
+        std::size_t Get_Dot_Count(void) const noexcept;
+
         // Get data for all dots
         std::set<uint64_t> Get_Data(void) const noexcept;
 
         // Check if it is worth adding a dot
         bool Check_Dot(const TDot* const Dot) const noexcept;
 
-        // Add dot
-        void Add_Dot(TDot* const Dot) noexcept;
+        // Add dot (Update_Center: false - the center is calculated later by Set_Center)
+        void Add_Dot(TDot* const Dot, const bool Update_Center = true) noexcept;
 
         // Check if it is worth adding a cluster_1
         bool Check_Cluster_1(const TCluster_1* const Cluster_1) const noexcept;
 
         // Absorb cluster_1
         void Eat_Cluster_1(TCluster_1*& Cluster_1) noexcept;
+
+        // Get the memory of maps of members in bytes
+        std::size_t Get_Member_Memory_Usage(void) const noexcept;
+
+        // Visit all dots of the cluster without copying, Visit returns false to stop visiting
+        template <typename Visitor> bool For_Each_Dot(Visitor&& Visit) const
+        {
+            for (const auto& dot : MapDot)
+            {
+                if (!Visit(dot.second))
+                    return false;
+            }
+
+            return true;
+        }
     };
 
     using TMapCluster_1   = std::map<TCoordKey, TCluster_1*>;
     using TMapCCluster_1  = std::map<TCoordKey, const TCluster_1*>;
+    using TVecCluster_1   = std::vector<TCluster_1*>;
 
     class TCluster_2 : public TClusteringElem
     {
@@ -144,6 +446,9 @@ namespace NS_Clustering
         TMapCDot        MapDot;        // dots
         TMapCCluster_1  MapCluster_1;  // clusters_1
 
+        std::size_t  DataCount;  // amount of data of all dots (is counted when elements are added)
+        std::size_t  DotCount;   // number of all dots (is counted when elements are added)
+
 
         TCluster_2(void) noexcept;
         TCluster_2(TDot* const Dot1, TDot* const Dot2) noexcept;
@@ -156,24 +461,49 @@ namespace NS_Clustering
         // Get the amount of data
         std::size_t Get_Count(void) const noexcept;
 
+        // Get the number of dots
+        std::size_t Get_Dot_Count(void) const noexcept;
+
         // Get data for all dots
         std::set<uint64_t> Get_Data(void) const noexcept;
 
         // Check if it is worth adding a clustering element
         bool Check_ClusteringElem(const TClusteringElem* const ClusteringElem) const noexcept;
 
-        // Add clustering element
-        void Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept;
+        // Add clustering element (Update_Center: false - the center is calculated later by Set_Center)
+        void Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center = true) noexcept;
 
         // Check if it is worth adding a cluster_2
         bool Check_Cluster_2(const TCluster_2* const Cluster_2) const noexcept;
 
         // Absorb cluster_2
         void Eat_Cluster_2(TCluster_2*& Cluster_2) noexcept;
+
+        // Get the memory of maps of members in bytes
+        std::size_t Get_Member_Memory_Usage(void) const noexcept;
+
+        // Visit all dots of the cluster without copying, Visit returns false to stop visiting
+        template <typename Visitor> bool For_Each_Dot(Visitor&& Visit) const
+        {
+            for (const auto& dot : MapDot)
+            {
+                if (!Visit(dot.second))
+                    return false;
+            }
+
+            for (const auto& c1 : MapCluster_1)
+            {
+                if (!c1.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            return true;
+        }
     };
 
     using TMapCluster_2   = std::map<TCoordKey, TCluster_2*>;
     using TMapCCluster_2  = std::map<TCoordKey, const TCluster_2*>;
+    using TVecCluster_2   = std::vector<TCluster_2*>;
 
     class TCluster_3 : public TClusteringElem
     {
@@ -182,6 +512,9 @@ namespace NS_Clustering
         TMapCCluster_1  MapCluster_1;  // clusters_1
         TMapCCluster_2  MapCluster_2;  // clusters_2
 
+        std::size_t  DataCount;  // amount of data of all dots (is counted when elements are added)
+        std::size_t  DotCount;   // number of all dots (is counted when elements are added)
+
 
         TCluster_3(void) noexcept;
         TCluster_3(TDot* const Dot1, TDot* const Dot2) noexcept;
@@ -194,24 +527,55 @@ namespace NS_Clustering
         // Get the amount of data
         std::size_t Get_Count(void) const noexcept;
 
+        // Get the number of dots
+        std::size_t Get_Dot_Count(void) const noexcept;
+
         // Get data for all dots
         std::set<uint64_t> Get_Data(void) const noexcept;
 
         // Check if it is worth adding a clustering element
         bool Check_ClusteringElem(const TClusteringElem* const ClusteringElem) const noexcept;
 
-        // Add clustering element
-        void Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept;
+        // Add clustering element (Update_Center: false - the center is calculated later by Set_Center)
+        void Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center = true) noexcept;
 
         // Check if it is worth adding a cluster_3
         bool Check_Cluster_3(const TCluster_3* const Cluster_3) const noexcept;
 
         // Absorb cluster_3
         void Eat_Cluster_3(TCluster_3*& Cluster_3) noexcept;
+
+        // Get the memory of maps of members in bytes
+        std::size_t Get_Member_Memory_Usage(void) const noexcept;
+
+        // Visit all dots of the cluster without copying, Visit returns false to stop visiting
+        template <typename Visitor> bool For_Each_Dot(Visitor&& Visit) const
+        {
+            for (const auto& dot : MapDot)
+            {
+                if (!Visit(dot.second))
+                    return false;
+            }
+
+            for (const auto& c1 : MapCluster_1)
+            {
+                if (!c1.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            for (const auto& c2 : MapCluster_2)
+            {
+                if (!c2.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            return true;
+        }
     };
 
     using TMapCluster_3   = std::map<TCoordKey, TCluster_3*>;
     using TMapCCluster_3  = std::map<TCoordKey, const TCluster_3*>;
+    using TVecCluster_3   = std::vector<TCluster_3*>;
 
     class TCluster_4 : public TClusteringElem
     {
@@ -221,6 +585,9 @@ namespace NS_Clustering
         TMapCCluster_2  MapCluster_2;  // clusters_2
         TMapCCluster_3  MapCluster_3;  // clusters_3
 
+        std::size_t  DataCount;  // amount of data of all dots (is counted when elements are added)
+        std::size_t  DotCount;   // number of all dots (is counted when elements are added)
+
 
         TCluster_4(void) noexcept;
         TCluster_4(TDot* const Dot1, TDot* const Dot2) noexcept;
@@ -233,24 +600,61 @@ namespace NS_Clustering
         // Get the amount of data
         std::size_t Get_Count(void) const noexcept;
 
+        // Get the number of dots
+        std::size_t Get_Dot_Count(void) const noexcept;
+
         // Get data for all dots
         std::set<uint64_t> Get_Data(void) const noexcept;
 
         // Check if it is worth adding a clustering element
         bool Check_ClusteringElem(const TClusteringElem* const ClusteringElem) const noexcept;
 
-        // Add clustering element
-        void Add_ClusteringElem(TClusteringElem* const ClusteringElem) noexcept;
+        // Add clustering element (Update_Center: false - the center is calculated later by Set_Center)
+        void Add_ClusteringElem(TClusteringElem* const ClusteringElem, const bool Update_Center = true) noexcept;
 
         // Check if it is worth adding a cluster_4
         bool Check_Cluster_4(const TCluster_4* const Cluster_4) const noexcept;
 
         // Absorb cluster_4
         void Eat_Cluster_4(TCluster_4*& Cluster_4) noexcept;
+
+        // Get the memory of maps of members in bytes
+        std::size_t Get_Member_Memory_Usage(void) const noexcept;
+
+        // Visit all dots of the cluster without copying, Visit returns false to stop visiting
+        template <typename Visitor> bool For_Each_Dot(Visitor&& Visit) const
+        {
+            for (const auto& dot : MapDot)
+            {
+                if (!Visit(dot.second))
+                    return false;
+            }
+
+            for (const auto& c1 : MapCluster_1)
+            {
+                if (!c1.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            for (const auto& c2 : MapCluster_2)
+            {
+                if (!c2.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            for (const auto& c3 : MapCluster_3)
+            {
+                if (!c3.second->For_Each_Dot(Visit))
+                    return false;
+            }
+
+            return true;
+        }
     };
 
     using TMapCluster_4   = std::map<TCoordKey, TCluster_4*>;
     using TMapCCluster_4  = std::map<TCoordKey, const TCluster_4*>;
+    using TVecCluster_4   = std::vector<TCluster_4*>;
 
     // Get the amount of data for clustering element
     template <typename Type> inline std::size_t ClusteringElem_Get_Count(const std::map<TCoordKey, Type*>& MapClusteringElem) noexcept
@@ -263,6 +667,45 @@ namespace NS_Clustering
         return result;
     }
 
+    // Visit datasets of all dots of the clustering element without copying, Visit is called with (const uint64_t* First, const uint64_t* Last)
+    template <typename Type, typename Visitor> inline void ClusteringElem_For_Each_Data(const Type& ClusteringElem, Visitor&& Visit)
+    {
+        ClusteringElem.For_Each_Dot([&Visit](const TDot* const Dot) { Visit(Dot->SetData.cbegin(), Dot->SetData.cend()); return true; });
+    }
+
+    // Change the amount of data and the number of dots of all clusters that contain the clustering element
+    void Change_Counts_Of_Parents(const TClusteringElem* const ClusteringElem, const std::ptrdiff_t DataCount_Delta, const std::ptrdiff_t DotCount_Delta) noexcept;
+
+    /* Index of tags: clustering elements with each tag. Whether the tag is inside a clustering element is checked by going up
+    from the elements with this tag through the clusters that contain them, so the check takes O(depth). The index must be
+    rebuilt after the clustering elements or their tags are changed. */
+    class TTagIndex
+    {
+    private:
+        std::unordered_multimap<uint64_t, const TClusteringElem*> MapTag; // clustering elements by tags
+
+    public:
+        // Build index for all clustering elements with tag
+        void Build(
+            const TMapDot&        MapDot,
+            const TMapCluster_1&  MapCluster_1,
+            const TMapCluster_2&  MapCluster_2,
+            const TMapCluster_3&  MapCluster_3,
+            const TMapCluster_4&  MapCluster_4);
+
+        // Clear index
+        void Clear(void) noexcept;
+
+        // Get the memory of the index in bytes
+        std::size_t Get_Memory_Usage(void) const noexcept;
+
+        // Does the clustering element or any clustering element inside it have the tag
+        bool Is_Have_Tag_Inside(const TClusteringElem* const ClusteringElem, const uint64_t Tag) const noexcept;
+
+        // Get all clustering elements that have the tag inside (for checking many clustering elements at once)
+        void Get_Elems_With_Tag_Inside(const uint64_t Tag, std::unordered_set<const TClusteringElem*>& SetClusteringElem) const;
+    };
+
     // Clear set of clustering elements
     template <typename Type> inline void Clear_Map_Of_ClusteringElem(std::map<TCoordKey, Type*>& MapClusteringElem) noexcept
     {
@@ -272,6 +715,91 @@ namespace NS_Clustering
         MapClusteringElem.clear();
     }
 
+    // Get the memory of nodes of the map in bytes
+    template <typename Key, typename Value> inline std::size_t Map_Get_Memory_Usage(const std::map<Key, Value>& Map) noexcept
+    {
+        return Map.size() * (sizeof(typename std::map<Key, Value>::value_type) + Map_Node_Overhead);
+    }
+
+    // Find clustering element in the set by its coordinates (nullptr - not found)
+    template <typename Type> inline const Type* Find_ClusteringElem(const std::map<TCoordKey, Type*>& MapClusteringElem, const double X, const double Y) noexcept
+    {
+        const auto cit = MapClusteringElem.find(TCoordKey(X, Y));
+
+        return cit != MapClusteringElem.cend() ? cit->second : nullptr;
+    }
+
+    // Get clustering element from the dense array by its index in O(1) (nullptr - there is no such index)
+    template <typename Type> inline const Type* Find_ClusteringElem(const std::vector<Type*>& VecClusteringElem, const uint32_t Index) noexcept
+    {
+        return Index < VecClusteringElem.size() ? VecClusteringElem[Index] : nullptr;
+    }
+
+    // Add clustering element to the end of the dense array of its level
+    template <typename Type> inline void Index_ClusteringElem(Type* const ClusteringElem, std::vector<Type*>& VecClusteringElem)
+    {
+        ClusteringElem->Index = static_cast<uint32_t>(VecClusteringElem.size());
+        VecClusteringElem.push_back(ClusteringElem);
+    }
+
+    // Remove clustering element from the dense array of its level in O(1), the last element takes its index
+    template <typename Type> inline void Unindex_ClusteringElem(Type* const ClusteringElem, std::vector<Type*>& VecClusteringElem) noexcept
+    {
+        Type* const last = VecClusteringElem.back();
+
+        last->Index                                  = ClusteringElem->Index;
+        VecClusteringElem[ClusteringElem->Index]     = last;
+        ClusteringElem->Index                        = INDEX_NONE;
+        VecClusteringElem.pop_back();
+    }
+
+    // Fill the dense array of the level by all clustering elements of the set, indices are assigned in the order of the set
+    template <typename Type> inline void Index_Map_Of_ClusteringElem(const std::map<TCoordKey, Type*>& MapClusteringElem, std::vector<Type*>& VecClusteringElem)
+    {
+        VecClusteringElem.clear();
+        VecClusteringElem.reserve(MapClusteringElem.size());
+
+        for (const auto& ce : MapClusteringElem)
+            Index_ClusteringElem(ce.second, VecClusteringElem);
+    }
+
+    // Add dots that are not indexed yet to the end of the dense array of dots, the indices of the indexed dots do not change
+    void Index_Dots(const TMapDot& MapDot, TVecDot& VecDot);
+
+    /* Load dots from arrays of coordinates and data (Data_Arr may be nullptr). Dots with the same coordinates are merged into
+    one dot with combined data, the existing dots of the set remain and receive the data of the loaded dots with the same
+    coordinates. Arrays are sorted in ThreadCount threads (0 - by the number of hardware threads), after which the set is
+    filled in a single pass. Datasets of new dots with several values are placed in one block of the arena, if specified.
+    Elements with NaN or infinite coordinates are skipped, their number is returned. */
+    uint32_t Load_Dots(
+        TMapDot&               MapDot,
+        const uint32_t         ArrSize,
+        const double* const    X_Arr,
+        const double* const    Y_Arr,
+        const uint64_t* const  Data_Arr,
+        TDotDataArena* const   Arena        = nullptr,
+        const uint32_t         ThreadCount  = 0);
+
+    /* Project geographic coordinates (degrees) to Web Mercator (meters) in ThreadCount threads (0 - by the number of hardware
+    threads). Latitudes beyond the edges of the square map are moved to the edges, coordinates out of the range of longitude and
+    latitude become NaN, so such dots are rejected when loaded. */
+    void Project_Web_Mercator(
+        const uint32_t       ArrSize,
+        const double* const  Lon_Arr,
+        const double* const  Lat_Arr,
+        double* const        X_Arr,
+        double* const        Y_Arr,
+        const uint32_t       ThreadCount = 0);
+
+    // Convert Web Mercator coordinates (meters) to geographic ones (degrees) in ThreadCount threads (0 - by the number of hardware threads)
+    void Unproject_Web_Mercator(
+        const uint32_t       ArrSize,
+        const double* const  X_Arr,
+        const double* const  Y_Arr,
+        double* const        Lon_Arr,
+        double* const        Lat_Arr,
+        const uint32_t       ThreadCount = 0);
+
     // Create set of clusters_1
     void Create_Clusters_1(
         TMapDot&        MapDot,
@@ -301,6 +829,46 @@ namespace NS_Clustering
         TMapCluster_3&  MapCluster_3,
         TMapCluster_4&  MapCluster_4,
         const bool      SingleClusteringElem_To_Cluster_4 = false);
+
+    /* Create set of clusters_N approximately by the grid with cells of the size of the radius of clusters_N, the elements are the
+    same as for Create_Clusters_N. The elements of each cell become one cluster in a single pass, a single element of a cell
+    becomes a cluster only with SingleClusteringElem_To_Cluster_N. With Merge_Neighbors the clusters of neighboring cells are
+    merged once by the rule of Create_Clusters_N (each cluster takes part in one merge at most). Error bounds for the radius R:
+    elements of one cluster are at most R * sqrt(2) apart (2 * R * sqrt(2) with Merge_Neighbors, the exact clusters allow elements
+    up to R from the center when they are added), elements closer than R to each other may be in different clusters (with
+    Merge_Neighbors - if the centers of their clusters are farther than R). The time is linear in the number of elements. */
+    void Create_Grid_Clusters_1(
+        TMapDot&        MapDot,
+        TMapCluster_1&  MapCluster_1,
+        const bool      SingleDot_To_Cluster_1  = false,
+        const bool      Merge_Neighbors         = false);
+
+    // Create set of clusters_2 approximately by the grid (see Create_Grid_Clusters_1)
+    void Create_Grid_Clusters_2(
+        TMapDot&        MapDot,
+        TMapCluster_1&  MapCluster_1,
+        TMapCluster_2&  MapCluster_2,
+        const bool      SingleClusteringElem_To_Cluster_2  = false,
+        const bool      Merge_Neighbors                    = false);
+
+    // Create set of clusters_3 approximately by the grid (see Create_Grid_Clusters_1)
+    void Create_Grid_Clusters_3(
+        TMapDot&        MapDot,
+        TMapCluster_1&  MapCluster_1,
+        TMapCluster_2&  MapCluster_2,
+        TMapCluster_3&  MapCluster_3,
+        const bool      SingleClusteringElem_To_Cluster_3  = false,
+        const bool      Merge_Neighbors                    = false);
+
+    // Create set of clusters_4 approximately by the grid (see Create_Grid_Clusters_1)
+    void Create_Grid_Clusters_4(
+        TMapDot&        MapDot,
+        TMapCluster_1&  MapCluster_1,
+        TMapCluster_2&  MapCluster_2,
+        TMapCluster_3&  MapCluster_3,
+        TMapCluster_4&  MapCluster_4,
+        const bool      SingleClusteringElem_To_Cluster_4  = false,
+        const bool      Merge_Neighbors                    = false);
 }
 
 #endif
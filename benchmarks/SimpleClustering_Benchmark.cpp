@@ -0,0 +1,541 @@
+﻿// Copyright 2020 Artyom Muntyanu. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+// except in compliance with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+
+/* Benchmark of the clustering library. Datasets are generated from the seed by the own generator, so they are the same on all
+   platforms and compilers, and results of different versions of the library can be compared. Usage:
+
+     SimpleClustering_Benchmark [--sizes 1000,10000,...] [--distributions uniform,blobs,...] [--seed N] [--output file.json]
+
+   Distributions: uniform, blobs (Gaussian blobs), highways (chains along polylines), duplicates (heavy duplicate coordinates),
+   hotspot (one dense spot). Sizes are from 1000 to 10000000 dots, by default up to 100000.
+
+   For each distribution and size the time, throughput, allocations and peak resident memory of the phases (loading dots,
+   creating clusters_1..4, exporting visible elements, getting data of visible elements) are written as JSON. */
+
+#include "SimpleClusteringLib.h"
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t>  AllocationCount(0);  // number of allocations by operator new
+    std::atomic<uint64_t>  AllocationSize(0);   // size of allocations by operator new
+
+    const double World_Size = 1000000.0; // size of the square area of dots
+
+    class TRandom // generator of random numbers, its sequence does not depend on the standard library
+    {
+    private:
+        uint64_t State;
+
+    public:
+        explicit TRandom(const uint64_t Seed) noexcept :
+            State(Seed)
+        {}
+
+        // Next random number (splitmix64)
+        uint64_t Next(void) noexcept
+        {
+            uint64_t z = (State += 0x9E3779B97F4A7C15ULL);
+
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+            return z ^ (z >> 31);
+        }
+
+        // Uniform number in [0, 1)
+        double Uniform(void) noexcept
+        {
+            return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        // Uniform number in [Min, Max)
+        double Uniform(const double Min, const double Max) noexcept
+        {
+            return Min + (Max - Min) * Uniform();
+        }
+
+        // Normally distributed number (Box-Muller)
+        double Gaussian(const double Mean, const double Sigma) noexcept
+        {
+            const double u = 1.0 - Uniform(); // (0, 1]
+
+            return Mean + Sigma * std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * Uniform());
+        }
+    };
+
+    struct TDataset // generated dots
+    {
+        std::vector<double>    X_Arr;
+        std::vector<double>    Y_Arr;
+        std::vector<uint64_t>  Data_Arr;
+    };
+
+    struct TPhase // result of one measured phase
+    {
+        std::string  Name;
+        double       Seconds;
+        uint64_t     Items;           // number of processed items (dots or clustering elements)
+        uint64_t     Allocations;     // number of allocations
+        uint64_t     AllocatedBytes;  // size of allocations
+    };
+
+    // Clamp the coordinate to the area of dots
+    double Clamp(const double Value) noexcept
+    {
+        return Value < 0.0 ? 0.0 : (Value >= World_Size ? World_Size : Value);
+    }
+
+    // Generate the dataset of the distribution, false - unknown distribution
+    bool Generate(const std::string& Distribution, const uint64_t Size, const uint64_t Seed, TDataset& Dataset)
+    {
+        TRandom random(Seed ^ (Size * 0x100000001B3ULL));
+
+        Dataset.X_Arr.resize(Size);
+        Dataset.Y_Arr.resize(Size);
+        Dataset.Data_Arr.resize(Size);
+
+        for (uint64_t i = 0; i < Size; ++i)
+            Dataset.Data_Arr[i] = i;
+
+        if (Distribution == "uniform") // dots are evenly distributed over the area
+        {
+            for (uint64_t i = 0; i < Size; ++i)
+            {
+                Dataset.X_Arr[i] = random.Uniform(0.0, World_Size);
+                Dataset.Y_Arr[i] = random.Uniform(0.0, World_Size);
+            }
+        }
+        else if (Distribution == "blobs") // dots are in Gaussian blobs of different sizes
+        {
+            const uint32_t       blob_count = 32;
+            std::vector<double>  blob_x(blob_count), blob_y(blob_count), blob_sigma(blob_count);
+
+            for (uint32_t b = 0; b < blob_count; ++b)
+            {
+                blob_x[b]      = random.Uniform(0.0, World_Size);
+                blob_y[b]      = random.Uniform(0.0, World_Size);
+                blob_sigma[b]  = random.Uniform(2000.0, 30000.0);
+            }
+
+            for (uint64_t i = 0; i < Size; ++i)
+            {
+                const uint32_t b = static_cast<uint32_t>(random.Next() % blob_count);
+
+                Dataset.X_Arr[i] = Clamp(random.Gaussian(blob_x[b], blob_sigma[b]));
+                Dataset.Y_Arr[i] = Clamp(random.Gaussian(blob_y[b], blob_sigma[b]));
+            }
+        }
+        else if (Distribution == "highways") // dots are in narrow chains along polylines
+        {
+            const uint32_t       vertex_count = 16 * 33; // 16 polylines of 32 segments
+            std::vector<double>  vertex_x(vertex_count), vertex_y(vertex_count);
+
+            for (uint32_t v = 0; v < vertex_count; ++v)
+            {
+                if (v % 33 == 0) // beginning of a polyline
+                {
+                    vertex_x[v] = random.Uniform(0.0, World_Size);
+                    vertex_y[v] = random.Uniform(0.0, World_Size);
+                }
+                else
+                {
+                    vertex_x[v] = Clamp(vertex_x[v - 1] + random.Uniform(-40000.0, 40000.0));
+                    vertex_y[v] = Clamp(vertex_y[v - 1] + random.Uniform(-40000.0, 40000.0));
+                }
+            }
+
+            for (uint64_t i = 0; i < Size; ++i)
+            {
+                const uint32_t  segment  = static_cast<uint32_t>(random.Next() % 512);
+                const uint32_t  v        = segment / 32 * 33 + segment % 32;
+                const double    t        = random.Uniform();
+
+                Dataset.X_Arr[i] = Clamp(vertex_x[v] + (vertex_x[v + 1] - vertex_x[v]) * t + random.Gaussian(0.0, 20.0));
+                Dataset.Y_Arr[i] = Clamp(vertex_y[v] + (vertex_y[v + 1] - vertex_y[v]) * t + random.Gaussian(0.0, 20.0));
+            }
+        }
+        else if (Distribution == "duplicates") // every 100 dots share the same coordinates on average
+        {
+            const uint64_t       position_count = Size / 100 + 1;
+            std::vector<double>  position_x(position_count), position_y(position_count);
+
+            for (uint64_t p = 0; p < position_count; ++p)
+            {
+                position_x[p] = random.Uniform(0.0, World_Size);
+                position_y[p] = random.Uniform(0.0, World_Size);
+            }
+
+            for (uint64_t i = 0; i < Size; ++i)
+            {
+                const uint64_t p = random.Next() % position_count;
+
+                Dataset.X_Arr[i] = position_x[p];
+                Dataset.Y_Arr[i] = position_y[p];
+            }
+        }
+        else if (Distribution == "hotspot") // all dots are in one dense spot
+        {
+            for (uint64_t i = 0; i < Size; ++i)
+            {
+                Dataset.X_Arr[i] = Clamp(random.Gaussian(World_Size / 2.0, 500.0));
+                Dataset.Y_Arr[i] = Clamp(random.Gaussian(World_Size / 2.0, 500.0));
+            }
+        }
+        else
+            return false;
+
+        return true;
+    }
+
+    // Get the peak resident memory of the process in bytes
+    uint64_t Get_Peak_RSS(void) noexcept
+    {
+        #if defined(_WIN32)
+          PROCESS_MEMORY_COUNTERS counters;
+
+          return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+        #else
+          struct rusage usage;
+
+          if (getrusage(RUSAGE_SELF, &usage) != 0)
+              return 0;
+
+          #if defined(__APPLE__)
+            return static_cast<uint64_t>(usage.ru_maxrss);        // bytes
+          #else
+            return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // kilobytes
+          #endif
+        #endif
+    }
+
+    // Reset the peak resident memory of the process to the current one, where it is possible
+    void Reset_Peak_RSS(void) noexcept
+    {
+        #if defined(__linux__)
+          if (std::FILE* const file = std::fopen("/proc/self/clear_refs", "w"))
+          {
+              std::fputs("5", file);
+              std::fclose(file);
+          }
+        #endif
+    }
+
+    // Measure the phase, Run returns the number of processed items
+    template <typename Function> TPhase Measure(const char* const Name, Function&& Run)
+    {
+        TPhase phase;
+
+        const uint64_t  allocation_count  = AllocationCount.load();
+        const uint64_t  allocation_size   = AllocationSize.load();
+        const auto      start             = std::chrono::steady_clock::now();
+
+        phase.Items           = Run();
+        phase.Seconds         = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        phase.Name            = Name;
+        phase.Allocations     = AllocationCount.load() - allocation_count;
+        phase.AllocatedBytes  = AllocationSize.load() - allocation_size;
+
+        return phase;
+    }
+
+    // Split the text by commas
+    std::vector<std::string> Split(const std::string& Text)
+    {
+        std::vector<std::string>  result;
+        std::size_t               first = 0;
+
+        while (first <= Text.size())
+        {
+            std::size_t last = Text.find(',', first);
+
+            if (last == std::string::npos)
+                last = Text.size();
+
+            if (last > first)
+                result.push_back(Text.substr(first, last - first));
+
+            first = last + 1;
+        }
+
+        return result;
+    }
+
+    // Run all phases for one dataset and write the result as a JSON object
+    bool Run_Benchmark(const std::string& Distribution, const uint64_t Size, const uint64_t Seed, std::FILE* const Output, const bool First)
+    {
+        using namespace NS_Clustering;
+
+        TDataset dataset;
+
+        if (!Generate(Distribution, Size, Seed, dataset))
+        {
+            std::fprintf(stderr, "Unknown distribution: %s\n", Distribution.c_str());
+
+            return false;
+        }
+
+        Reset_Peak_RSS();
+
+        const uint32_t         id = Clusterizator_New();
+        std::vector<TPhase>    phases;
+        std::vector<uint16_t>  id_arr;          // visible clustering elements
+        std::vector<uint32_t>  index_arr;
+        std::vector<uint64_t>  data_count_arr;
+
+        phases.push_back(Measure("load", [&]() -> uint64_t
+        {
+            const uint64_t* data_arr = dataset.Data_Arr.data();
+
+            Clusterizator_Init_Dots(id, static_cast<uint32_t>(Size), dataset.X_Arr.data(), dataset.Y_Arr.data(), &data_arr);
+
+            return Size;
+        }));
+
+        // Items of the creation of clusters of each level are its input: clustering elements of the lower levels which are not in any cluster
+        const uint16_t  lower_levels[] = { ID_DOT, ID_CLUSTER_1, ID_CLUSTER_2, ID_CLUSTER_3 };
+        uint64_t        input_count    = 0;
+
+        Clusterizator_Get_Visible_ClusteringElems(id, lower_levels, 1, 0, nullptr, nullptr, nullptr, nullptr, nullptr, input_count);
+        phases.push_back(Measure("create_clusters_1", [&]() -> uint64_t { Clusterizator_Create_Clusters_1(id, 0); return input_count; }));
+        Clusterizator_Get_Visible_ClusteringElems(id, lower_levels, 2, 0, nullptr, nullptr, nullptr, nullptr, nullptr, input_count);
+        phases.push_back(Measure("create_clusters_2", [&]() -> uint64_t { Clusterizator_Create_Clusters_2(id, 0); return input_count; }));
+        Clusterizator_Get_Visible_ClusteringElems(id, lower_levels, 3, 0, nullptr, nullptr, nullptr, nullptr, nullptr, input_count);
+        phases.push_back(Measure("create_clusters_3", [&]() -> uint64_t { Clusterizator_Create_Clusters_3(id, 0); return input_count; }));
+        Clusterizator_Get_Visible_ClusteringElems(id, lower_levels, 4, 0, nullptr, nullptr, nullptr, nullptr, nullptr, input_count);
+        phases.push_back(Measure("create_clusters_4", [&]() -> uint64_t { Clusterizator_Create_Clusters_4(id, 0); return input_count; }));
+
+        phases.push_back(Measure("export", [&]() -> uint64_t
+        {
+            const uint16_t  levels[] = { ID_DOT, ID_CLUSTER_1, ID_CLUSTER_2, ID_CLUSTER_3, ID_CLUSTER_4 };
+            uint64_t        count    = 0;
+
+            Clusterizator_Get_Visible_ClusteringElems(id, levels, 5, 0, nullptr, nullptr, nullptr, nullptr, nullptr, count);
+
+            std::vector<double> x_arr(count), y_arr(count);
+
+            id_arr.resize(count);
+            index_arr.resize(count);
+            data_count_arr.resize(count);
+
+            Clusterizator_Get_Visible_ClusteringElems(id, levels, 5, count, id_arr.data(), x_arr.data(), y_arr.data(), data_count_arr.data(), index_arr.data(), count);
+
+            return count;
+        }));
+
+        phases.push_back(Measure("get_data", [&]() -> uint64_t
+        {
+            uint64_t               result = 0;
+            std::vector<uint64_t>  data_arr;
+
+            for (std::size_t i = 0; i < id_arr.size(); ++i)
+            {
+                data_arr.resize(data_count_arr[i]);
+
+                if (Clusterizator_Get_ClusteringElem_Data_By_Index(id, id_arr[i], index_arr[i], data_arr.data()) == 0)
+                    result += data_count_arr[i];
+            }
+
+            return result;
+        }));
+
+        const uint64_t  dot_count  = Clusterizator_Get_ClusteringElem_Count(id, ID_DOT);
+        const uint64_t  peak_rss   = Get_Peak_RSS();
+
+        uint64_t cluster_count[4];
+
+        for (uint16_t level = 0; level < 4; ++level)
+            cluster_count[level] = Clusterizator_Get_ClusteringElem_Count(id, static_cast<uint16_t>(ID_CLUSTER_1 + level));
+
+        TStats      stats[4];                                           // counters of creating clusters_1..4
+        const bool  has_stats = Clusterizator_Get_Stats(id, stats) == 0;  // the library is built with SIMPLE_CLUSTERING_STATS
+
+        Clusterizator_Delete(id);
+
+        std::fprintf(Output, "%s    {\"distribution\": \"%s\", \"points\": %llu, \"dots\": %llu, \"clusters\": [%llu, %llu, %llu, %llu], \"peak_rss_bytes\": %llu, \"phases\": [",
+            First ? "" : ",\n", Distribution.c_str(), static_cast<unsigned long long>(Size), static_cast<unsigned long long>(dot_count),
+            static_cast<unsigned long long>(cluster_count[0]), static_cast<unsigned long long>(cluster_count[1]),
+            static_cast<unsigned long long>(cluster_count[2]), static_cast<unsigned long long>(cluster_count[3]), static_cast<unsigned long long>(peak_rss));
+
+        for (std::size_t i = 0; i < phases.size(); ++i)
+        {
+            const TPhase& phase = phases[i];
+
+            std::fprintf(Output, "%s\n      {\"name\": \"%s\", \"seconds\": %.9f, \"items\": %llu, \"items_per_second\": %.1f, \"allocations\": %llu, \"allocated_bytes\": %llu}",
+                i ? "," : "", phase.Name.c_str(), phase.Seconds, static_cast<unsigned long long>(phase.Items),
+                phase.Seconds > 0.0 ? static_cast<double>(phase.Items) / phase.Seconds : 0.0,
+                static_cast<unsigned long long>(phase.Allocations), static_cast<unsigned long long>(phase.AllocatedBytes));
+        }
+
+        std::fprintf(Output, "]");
+
+        if (has_stats)
+        {
+            std::fprintf(Output, ", \"stats\": [");
+
+            for (uint16_t level = 0; level < 4; ++level)
+            {
+                const TStats& st = stats[level];
+
+                std::fprintf(Output, "%s\n      {\"name\": \"create_clusters_%u\", \"coord_in_circle\": %llu, \"merge_passes\": %llu, \"merges\": %llu, \"set_center\": %llu, \"allocations\": %llu, \"nanoseconds\": %llu}",
+                    level ? "," : "", level + 1u, static_cast<unsigned long long>(st.Coord_In_Circle_Count), static_cast<unsigned long long>(st.Merge_Pass_Count),
+                    static_cast<unsigned long long>(st.Merge_Count), static_cast<unsigned long long>(st.Set_Center_Count),
+                    static_cast<unsigned long long>(st.Allocation_Count), static_cast<unsigned long long>(st.Nanoseconds));
+            }
+
+            std::fprintf(Output, "]");
+        }
+
+        std::fprintf(Output, "}");
+        std::fflush(Output);
+
+        return true;
+    }
+}
+
+// Allocations of the library are counted by replacing the global operator new
+void* operator new(std::size_t Size)
+{
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    AllocationSize.fetch_add(Size, std::memory_order_relaxed);
+
+    if (void* const p = std::malloc(Size ? Size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t Size)
+{
+    return operator new(Size);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+    std::free(Ptr);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+    std::free(Ptr);
+}
+
+void operator delete(void* Ptr, std::size_t) noexcept
+{
+    std::free(Ptr);
+}
+
+void operator delete[](void* Ptr, std::size_t) noexcept
+{
+    std::free(Ptr);
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string>  sizes          = { "1000", "10000", "100000" }; // up to 10000000 by --sizes
+    std::vector<std::string>  distributions  = { "uniform", "blobs", "highways", "duplicates", "hotspot" };
+    uint64_t                  seed           = 20200101;
+    const char*               output_name    = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string  arg    = argv[i];
+        const char*        value  = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (!value)
+        {
+            std::fprintf(stderr, "No value of the argument %s\n", arg.c_str());
+
+            return 1;
+        }
+
+        if (arg == "--sizes")
+            sizes = Split(value);
+        else if (arg == "--distributions")
+            distributions = Split(value);
+        else if (arg == "--seed")
+            seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--output")
+            output_name = value;
+        else
+        {
+            std::fprintf(stderr, "Unknown argument %s\n", arg.c_str());
+
+            return 1;
+        }
+
+        ++i;
+    }
+
+    std::FILE* const output = output_name ? std::fopen(output_name, "w") : stdout;
+
+    if (!output)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", output_name);
+
+        return 1;
+    }
+
+    std::fprintf(output, "{\n  \"benchmark\": \"SimpleClustering\",\n  \"seed\": %llu,\n  \"runs\": [\n", static_cast<unsigned long long>(seed));
+
+    bool  result  = true;
+    bool  first   = true;
+
+    for (const auto& distribution : distributions)
+    {
+        for (const auto& size : sizes)
+        {
+            const uint64_t count = std::strtoull(size.c_str(), nullptr, 10);
+
+            if (count == 0 || count > 0xFFFFFFFFULL)
+            {
+                std::fprintf(stderr, "Incorrect size: %s\n", size.c_str());
+                result = false;
+
+                continue;
+            }
+
+            if (!Run_Benchmark(distribution, count, seed, output, first))
+            {
+                result = false;
+
+                break;
+            }
+
+            first = false;
+        }
+    }
+
+    std::fprintf(output, "\n  ]\n}\n");
+
+    if (output != stdout)
+        std::fclose(output);
+
+    return result ? 0 : 1;
+}
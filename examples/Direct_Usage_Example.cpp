@@ -30,7 +30,7 @@ Function_In_Which_All_Dots_Are_Prepared()
 
         /* Add single dot with it coordinates and uint64_t data (for example pointer for data).
            One dot may contain a data set, so you can add this different data to it several times.
-           Data will be added to std::set and will be unique. */
+           Data will be added to the sorted dataset of the dot and will be unique. */
         auto dot = MapDot.find(TCoordKey(x, y)); // find dot with specified coordinates
 
         if (dot == MapDot.end()) // not found
@@ -42,6 +42,10 @@ Function_In_Which_All_Dots_Are_Prepared()
 
         ...
     }
+
+    /* Or, if the dots are already prepared in arrays, load them all at once. Dots with the same coordinates
+       are merged into one dot with combined data, the arrays are sorted in several threads. */
+    Load_Dots(MapDot, dot_count, x_arr, y_arr, data_arr);
 }
 
 Function_In_Which_Clustering_Occurs_Depending_On_The_Current_Zoom_Level_On_The_Map()
@@ -102,4 +106,4 @@ Function_In_Which_Cluster_Information_Is_Loaded_To_Create_Graphic_Elements_For_M
 
     // If need to display clusters_N
     if ...
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -39,7 +39,7 @@ Function_In_Which_All_Dots_Are_Prepared()
 
         /* 1. Add single dot with it coordinates and uint64_t data (for example pointer for data).
               One dot may contain a data set, so you can add this different data to it several times.
-              Data will be added to std::set and will be unique.
+              Data will be added to the sorted dataset of the dot and will be unique.
            2. If necessary, you can get the address of the additional field of dot - Tag.
               It can store information that describes the dot.
               You can change it if some of your conditions are true. For example you can update dot
@@ -131,3 +131,40 @@ Function_In_Which_Cluster_Information_Is_Loaded_To_Create_Graphic_Elements_For_M
     // If need to display clusters_N
     if ...
 }
+
+// The same, but all visible clustering elements are got in one call
+Function_In_Which_Visible_Elements_Are_Loaded_To_Create_Graphic_Elements_For_Map()
+{
+    ... // clear all graphic elements for map
+
+    std::vector<uint16_t> id_list; // ids of clustering elements to display
+
+    if (MapControl->ZoomLevel >= VISIBLE_LEVEL_DOTS_START)
+        id_list.push_back(*Clustering.ID_DOT);
+    if (MapControl->ZoomLevel >= VISIBLE_LEVEL_CLUSTER_1_START && MapControl->ZoomLevel <= VISIBLE_LEVEL_CLUSTER_1_END)
+        id_list.push_back(*Clustering.ID_CLUSTER_1);
+    if ...
+
+    static std::vector<uint16_t>  id_arr;          // arrays are kept between frames, so they are rarely reallocated
+    static std::vector<double>    x_arr;
+    static std::vector<double>    y_arr;
+    static std::vector<uint64_t>  data_count_arr;
+    uint64_t                      count = 0;
+
+    // If arrays are too small, the required size is returned in count and the call is repeated
+    while (Clustering.Clusterizator_Get_Visible_ClusteringElems(ClusterizatorId, id_list.data(), static_cast<uint32_t>(id_list.size()), x_arr.size(), id_arr.data(), x_arr.data(), y_arr.data(), data_count_arr.data(), nullptr, count) != 0 && count > x_arr.size())
+    {
+        id_arr.resize(count);
+        x_arr.resize(count);
+        y_arr.resize(count);
+        data_count_arr.resize(count);
+    }
+
+    for (uint64_t i = 0; i < count; ++i) // only elements which are not in any cluster
+    {
+        // Your function to create ellipse from coordinates and radius of the clustering element id_arr[i]
+        auto ellipse = CreateEllipse(x_arr[i], y_arr[i], ...);
+
+        ... // other actions
+    }
+}
@@ -12,9 +12,24 @@
 
 #include "SimpleClusteringLib.h"
 
-#include <windows.h>
-
-BOOL WINAPI DllMain(HINSTANCE, DWORD, LPVOID) { return 1; }
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+  BOOL WINAPI DllMain(HINSTANCE, DWORD, LPVOID) { return 1; }
+#endif
 
 namespace NS_Clustering
 {
@@ -33,436 +48,3374 @@ namespace NS_Clustering
     const double   AdditionalRadiusValue_      = AdditionalRadiusValue;
     const int16_t  Use_AdditionalRadiusValue_  = Use_AdditionalRadiusValue;
 
-    TMapClusterizator MapClusterizator;
-}
+    TClusterizatorRegistry Registry;
 
-/*** TClusterizator *********************************************************************************/
-NS_Clustering::TClusterizator::TClusterizator(void) noexcept :
-    Id(0)
-{}
+    /* Snapshot file: header, dots, values of datasets of dots, clusters_1, clusters_2, clusters_3, clusters_4, members of clusters.
+    Records have the native byte order and the size multiple of 8, so all sections are aligned and are read in place. */
+    static const char      Snapshot_Magic[8]  = { 'S', 'C', 'L', 'S', 'N', 'A', 'P', '\0' };
+    static const uint32_t  Snapshot_Version   = 1;
 
-NS_Clustering::TClusterizator::TClusterizator(const uint32_t Id_) noexcept :
-    Id(Id_)
+    struct TSnapshotHeader
+    {
+        char      Magic[8];          // Snapshot_Magic
+        uint32_t  Version;           // Snapshot_Version
+        uint32_t  HeaderSize;        // size of the header
+        uint64_t  FileSize;          // size of the file
+        uint64_t  DotCount;          // number of dots
+        uint64_t  DataCount;         // number of values of datasets of all dots
+        uint64_t  ClusterCount[4];   // number of clusters of each level
+        uint64_t  MemberCount;       // number of members of all clusters
+        uint64_t  DotOffset;         // position of dots in the file
+        uint64_t  DataOffset;        // position of values of datasets in the file
+        uint64_t  ClusterOffset[4];  // position of clusters of each level in the file
+        uint64_t  MemberOffset;      // position of members of clusters in the file
+    };
+
+    struct TSnapshotDot
+    {
+        double    X;
+        double    Y;
+        uint64_t  Tag;
+        uint64_t  DataFirst;  // position of the first value of the dataset among values of all datasets
+        uint32_t  DataSize;   // number of values of the dataset
+        uint32_t  InCluster;
+    };
+
+    struct TSnapshotCluster
+    {
+        double    X;
+        double    Y;
+        double    R;
+        uint64_t  Tag;
+        uint64_t  DataCount;
+        uint64_t  DotCount;
+        uint64_t  MemberFirst;  // position of the first member among members of all clusters
+        uint32_t  MemberSize;   // number of members
+        uint32_t  InCluster;
+    };
+
+    struct TSnapshotMember // clustering element that is directly contained in the cluster
+    {
+        uint32_t  ClusteringElemId;
+        uint32_t  Index;
+    };
+}
+
+/*** TMappedFile ************************************************************************************/
+NS_Clustering::TMappedFile::TMappedFile(void) noexcept :
+    Data(nullptr),
+    Size(0)
 {}
 
-NS_Clustering::TClusterizator::~TClusterizator(void) noexcept
+NS_Clustering::TMappedFile::~TMappedFile(void) noexcept
 {
-    Clear(); // clear all data
+    Close(); // unmap the file
 }
 
-// Clear all data
-void NS_Clustering::TClusterizator::Clear() noexcept
+// Map the file into memory
+bool NS_Clustering::TMappedFile::Open(const char* const FileName) noexcept
 {
-    Clear_Map_Of_ClusteringElem(MapCluster_4);  // clear the set of clusters_4
-    Clear_Map_Of_ClusteringElem(MapCluster_3);  // clear the set of clusters_3
-    Clear_Map_Of_ClusteringElem(MapCluster_2);  // clear the set of clusters_2
-    Clear_Map_Of_ClusteringElem(MapCluster_1);  // clear the set of clusters_1
-    Clear_Map_Of_ClusteringElem(MapDot);        // clear the set of dots
+    Close();
+
+    #if defined(_WIN32)
+      const HANDLE file = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+      if (file == INVALID_HANDLE_VALUE)
+          return false;
+
+      LARGE_INTEGER size;
+
+      if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+      {
+          const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+          if (mapping)
+          {
+              Data  = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+              Size  = Data ? static_cast<std::size_t>(size.QuadPart) : 0;
+
+              CloseHandle(mapping); // the view keeps the mapping
+          }
+      }
+
+      CloseHandle(file);
+    #else
+      const int file = open(FileName, O_RDONLY);
+
+      if (file < 0)
+          return false;
+
+      struct stat st;
+
+      if (fstat(file, &st) == 0 && st.st_size > 0)
+      {
+          void* const data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+          if (data != MAP_FAILED)
+          {
+              Data  = static_cast<const uint8_t*>(data);
+              Size  = static_cast<std::size_t>(st.st_size);
+          }
+      }
+
+      close(file); // the mapping keeps the file
+    #endif
+
+    return Data != nullptr;
 }
 
-// Get the amount of data
-std::size_t NS_Clustering::TClusterizator::Get_Count(const uint16_t ClusteringElemId, bool All) const noexcept
+// Unmap the file
+void NS_Clustering::TMappedFile::Close(void) noexcept
 {
-    std::size_t result = 0;
-
-    if (All) // all clustering elements
+    if (Data)
     {
-        result = ClusteringElem_Get_Count(MapDot) + ClusteringElem_Get_Count(MapCluster_1) + ClusteringElem_Get_Count(MapCluster_2) +
-            ClusteringElem_Get_Count(MapCluster_3) + ClusteringElem_Get_Count(MapCluster_4);
+        #if defined(_WIN32)
+          UnmapViewOfFile(Data);
+        #else
+          munmap(const_cast<uint8_t*>(Data), Size);
+        #endif
+
+        Data  = nullptr;
+        Size  = 0;
     }
-    else // specified clustering elements
-    {
-        switch (ClusteringElemId)
-        {
-            case ID_DOT:       { result = ClusteringElem_Get_Count(MapDot); break; }
-            case ID_CLUSTER_1: { result = ClusteringElem_Get_Count(MapCluster_1); break; }
-            case ID_CLUSTER_2: { result = ClusteringElem_Get_Count(MapCluster_2); break; }
-            case ID_CLUSTER_3: { result = ClusteringElem_Get_Count(MapCluster_3); break; }
-            case ID_CLUSTER_4: { result = ClusteringElem_Get_Count(MapCluster_4); break; }
+}
 
-            default: break;
-        }
-    }
+// Get the contents of the file
+const uint8_t* NS_Clustering::TMappedFile::Get_Data(void) const noexcept
+{
+    return Data;
+}
 
-    return result;
+// Get the size of the file
+std::size_t NS_Clustering::TMappedFile::Get_Size(void) const noexcept
+{
+    return Size;
 }
 /****************************************************************************************************/
 
 
-// Reset radius of all clustering elements to default values
-void NS_Clustering::ClusteringElems_Set_Default_Radius(void) noexcept
+/*** TClusteringElemArrays **************************************************************************/
+NS_Clustering::TClusteringElemArrays::TClusteringElemArrays(void) noexcept :
+    Actual(false)
+{}
+
+// Get the view of arrays
+NS_Clustering::TClusteringElemView NS_Clustering::TClusteringElemArrays::Get_View(void) const noexcept
 {
-    Dot_Radius        = 10.0;
-    Cluster_1_Radius  = 50.0;
-    Cluster_2_Radius  = 300.0;
-    Cluster_3_Radius  = 1500.0;
-    Cluster_4_Radius  = 10000.0;
+    TClusteringElemView view;
+
+    view.Count             = static_cast<uint32_t>(X_Arr.size());
+    view.X_Arr             = X_Arr.data();
+    view.Y_Arr             = Y_Arr.data();
+    view.DataCount_Arr     = DataCount_Arr.data();
+    view.DotCount_Arr      = DotCount_Arr.data();
+    view.Parent_Id_Arr     = Parent_Id_Arr.data();
+    view.Parent_Index_Arr  = Parent_Index_Arr.data();
+    view.Selected_Arr      = Selected_Arr.data();
+
+    return view;
+}
 
-    const_cast<double&>(Dot_Radius_)        = Dot_Radius;
-    const_cast<double&>(Cluster_1_Radius_)  = Cluster_1_Radius;
-    const_cast<double&>(Cluster_2_Radius_)  = Cluster_2_Radius;
-    const_cast<double&>(Cluster_3_Radius_)  = Cluster_3_Radius;
-    const_cast<double&>(Cluster_4_Radius_)  = Cluster_4_Radius;
+// Get the memory of arrays in bytes
+std::size_t NS_Clustering::TClusteringElemArrays::Get_Memory_Usage(void) const noexcept
+{
+    return
+        X_Arr.capacity() * sizeof(double) +
+        Y_Arr.capacity() * sizeof(double) +
+        DataCount_Arr.capacity() * sizeof(uint64_t) +
+        DotCount_Arr.capacity() * sizeof(uint64_t) +
+        Parent_Id_Arr.capacity() * sizeof(uint16_t) +
+        Parent_Index_Arr.capacity() * sizeof(uint32_t) +
+        Selected_Arr.capacity() * sizeof(uint8_t);
 }
+/****************************************************************************************************/
 
-// Set the radius of all clustering elements
-int32_t NS_Clustering::ClusteringElems_Set_Radius(const double Dot_R, const double Cluster_1_R, const double Cluster_2_R, const double Cluster_3_R, const double Cluster_4_R) noexcept
+
+/*** TDotTimeWindow *********************************************************************************/
+// Set the time of the dot
+void NS_Clustering::TDotTimeWindow::Set_Time(TDot* const Dot, const int64_t Time)
 {
-    if (Dot_R > 0 &&
-        Cluster_1_R > Dot_R &&
-        Cluster_2_R > Cluster_1_R &&
-        Cluster_3_R > Cluster_2_R &&
-        Cluster_4_R > Cluster_3_R)
-    {
-        Dot_Radius        = Dot_R;
-        Cluster_1_Radius  = Cluster_1_R;
-        Cluster_2_Radius  = Cluster_2_R;
-        Cluster_3_Radius  = Cluster_3_R;
-        Cluster_4_Radius  = Cluster_4_R;
+    const auto result = MapTime.emplace(Dot, Time);
 
-        const_cast<double&>(Dot_Radius_)        = Dot_Radius;
-        const_cast<double&>(Cluster_1_Radius_)  = Cluster_1_Radius;
-        const_cast<double&>(Cluster_2_Radius_)  = Cluster_2_Radius;
-        const_cast<double&>(Cluster_3_Radius_)  = Cluster_3_Radius;
-        const_cast<double&>(Cluster_4_Radius_)  = Cluster_4_Radius;
+    if (!result.second) // the dot is already timed
+    {
+        if (Time <= result.first->second) // the earlier time does not prolong the dot
+            return;
 
-        return 0;
+        result.first->second = Time;
     }
-    else
-        return 1;
+
+    Queue.push(TEntry{Time, Dot});
 }
 
-// Reset settings of the additional radius value to default
-void NS_Clustering::ClusteringElems_Set_Default_AdditionalRadiusValue_Settings(void) noexcept
+// Whether the dot has time
+bool NS_Clustering::TDotTimeWindow::Is_Timed(const TDot* const Dot) const noexcept
 {
-    AdditionalRadiusValue      = 3.0;
-    Use_AdditionalRadiusValue  = 1;
-
-    const_cast<double&>(AdditionalRadiusValue_)       = AdditionalRadiusValue;
-    const_cast<int16_t&>(Use_AdditionalRadiusValue_)  = Use_AdditionalRadiusValue;
+    return MapTime.find(Dot) != MapTime.cend();
 }
 
-// Set settings of the additional radius value
-void NS_Clustering::ClusteringElems_Set_AdditionalRadiusValue_Settings(const double Value, const int16_t Usage) noexcept
+// Take out the dots whose latest time is earlier than Min_Time
+void NS_Clustering::TDotTimeWindow::Take_Expired(const int64_t Min_Time, std::vector<TDot*>& VecExpired)
 {
-    if (Value < Dot_Radius_ && (Usage == 0 || Usage == 1))
+    while (!Queue.empty() && Queue.top().Time < Min_Time)
     {
-        AdditionalRadiusValue      = Value;
-        Use_AdditionalRadiusValue  = Usage;
+        const TEntry entry = Queue.top();
 
-        const_cast<double&>(AdditionalRadiusValue_)       = AdditionalRadiusValue;
-        const_cast<int16_t&>(Use_AdditionalRadiusValue_)  = Use_AdditionalRadiusValue;
+        Queue.pop();
+
+        // The entry is actual only for the latest time of the dot, all older entries of the dot come out before it
+        const auto it = MapTime.find(entry.Dot);
+
+        if (it != MapTime.end() && it->second == entry.Time)
+        {
+            MapTime.erase(it);
+            VecExpired.push_back(entry.Dot);
+        }
     }
 }
 
+// Forget all times
+void NS_Clustering::TDotTimeWindow::Clear(void) noexcept
+{
+    MapTime.clear();
+    Queue = decltype(Queue)(); // free the memory of the queue
+}
 
-// Create a new clusterizator. Its code is returned
-uint32_t NS_Clustering::Clusterizator_New(void) noexcept
+// Get the memory of times in bytes
+std::size_t NS_Clustering::TDotTimeWindow::Get_Memory_Usage(void) const noexcept
 {
-    const uint32_t size = static_cast<uint32_t>(MapClusterizator.size());
+    return
+        MapTime.size() * (sizeof(decltype(MapTime)::value_type) + 2 * sizeof(void*)) + MapTime.bucket_count() * sizeof(void*) +
+        Queue.size() * sizeof(TEntry);
+}
+/****************************************************************************************************/
 
-    MapClusterizator[size + 1].Id = size + 1;
 
-    return size + 1;
+/*** TClusterizator *********************************************************************************/
+NS_Clustering::TClusterizator::TClusterizator(void) noexcept :
+    Id              (0),
+    TagIndex_Actual (false),
+    TagIndex_Enabled(false),
+    Stats           ()
+{}
+
+NS_Clustering::TClusterizator::TClusterizator(const uint32_t Id_) noexcept :
+    Id              (Id_),
+    TagIndex_Actual (false),
+    TagIndex_Enabled(false),
+    Stats           ()
+{}
+
+NS_Clustering::TClusterizator::~TClusterizator(void) noexcept
+{
+    Clear(); // clear all data
 }
 
-// Delete clusterizator
-int32_t NS_Clustering::Clusterizator_Delete(const uint32_t ClusterizatorId) noexcept
+// Clear all data
+void NS_Clustering::TClusterizator::Clear() noexcept
 {
-    if (ClusterizatorId > 0 && MapClusterizator.find(ClusterizatorId) != MapClusterizator.end())
-    {
-        MapClusterizator.erase(ClusterizatorId);
+    Clear_Map_Of_ClusteringElem(MapCluster_4);  // clear the set of clusters_4
+    Clear_Map_Of_ClusteringElem(MapCluster_3);  // clear the set of clusters_3
+    Clear_Map_Of_ClusteringElem(MapCluster_2);  // clear the set of clusters_2
+    Clear_Map_Of_ClusteringElem(MapCluster_1);  // clear the set of clusters_1
+    Clear_Map_Of_ClusteringElem(MapDot);        // clear the set of dots
+    VecCluster_4.clear();                       // clear indices of clusters_4
+    VecCluster_3.clear();                       // clear indices of clusters_3
+    VecCluster_2.clear();                       // clear indices of clusters_2
+    VecCluster_1.clear();                       // clear indices of clusters_1
+    VecDot.clear();                             // clear indices of dots
+    DataArena.Clear();                          // free datasets of dots
+    Snapshot.reset();                           // unmap the snapshot that datasets of dots referred to
+    TagIndex.Clear();                           // clear the index of tags
+    TimeWindow.Clear();                         // forget times of dots
+
+    TagIndex_Actual = false;
+    Views_Changed();
+}
 
+// Move datasets of dots that refer to the arena into one new block and free the old blocks
+uint64_t NS_Clustering::TClusterizator::Compact_Dot_Data(const bool Force)
+{
+    if (!DataArena.Note_Load() && !Force)
         return 0;
-    }
-    else
-        return 1;
+
+    std::vector<TDotData*> vec_data; // datasets of all dots
+
+    vec_data.reserve(VecDot.size());
+
+    for (TDot* const dot : VecDot)
+        vec_data.push_back(&dot->SetData);
+
+    return DataArena.Compact(vec_data) * sizeof(uint64_t);
 }
 
-// Delete all clusterizators
-void NS_Clustering::Clusterizator_Delete_All(void) noexcept
+// Clear all sets of clusters
+void NS_Clustering::TClusterizator::Clear_Clusters(void) noexcept
 {
-    MapClusterizator.clear();
-}
+    Clear_Map_Of_ClusteringElem(MapCluster_4);
+    Clear_Map_Of_ClusteringElem(MapCluster_3);
+    Clear_Map_Of_ClusteringElem(MapCluster_2);
+    Clear_Map_Of_ClusteringElem(MapCluster_1);
+    VecCluster_4.clear();
+    VecCluster_3.clear();
+    VecCluster_2.clear();
+    VecCluster_1.clear();
+
+    for (auto& dot : MapDot)
+    {
+        dot.second->InCluster  = false;
+        dot.second->Parent     = nullptr;
+    }
 
+    TagIndex_Actual = false; // clusters are deleted
+    Views_Changed();
+}
 
-// Initialize a set of dots
-int32_t NS_Clustering::Clusterizator_Init_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr)
+namespace NS_Clustering
 {
-    if (ClusterizatorId > 0 && ArrSize > 0 && X_Arr && Y_Arr)
+    // Get the number of clustering elements directly contained in the cluster
+    std::size_t Get_Member_Count(const TClusteringElem* const Cluster) noexcept
+    {
+        switch (Cluster->Get_ClusteringElem_Id())
+        {
+            case ID_CLUSTER_1: { const auto c1 = static_cast<const TCluster_1*>(Cluster); return c1->MapDot.size(); }
+            case ID_CLUSTER_2: { const auto c2 = static_cast<const TCluster_2*>(Cluster); return c2->MapDot.size() + c2->MapCluster_1.size(); }
+            case ID_CLUSTER_3: { const auto c3 = static_cast<const TCluster_3*>(Cluster); return c3->MapDot.size() + c3->MapCluster_1.size() + c3->MapCluster_2.size(); }
+            case ID_CLUSTER_4: { const auto c4 = static_cast<const TCluster_4*>(Cluster); return c4->MapDot.size() + c4->MapCluster_1.size() + c4->MapCluster_2.size() + c4->MapCluster_3.size(); }
+
+            default: return 0;
+        }
+    }
+
+    // Get the amount of data and the number of dots of the clustering element
+    void Get_Counts(const TClusteringElem* const ClusteringElem, std::size_t& DataCount, std::size_t& DotCount) noexcept
+    {
+        switch (ClusteringElem->Get_ClusteringElem_Id())
+        {
+            case ID_DOT:       { DataCount = static_cast<const TDot*>(ClusteringElem)->Get_Count(); DotCount = 1; break; }
+            case ID_CLUSTER_1: { DataCount = static_cast<const TCluster_1*>(ClusteringElem)->DataCount; DotCount = static_cast<const TCluster_1*>(ClusteringElem)->DotCount; break; }
+            case ID_CLUSTER_2: { DataCount = static_cast<const TCluster_2*>(ClusteringElem)->DataCount; DotCount = static_cast<const TCluster_2*>(ClusteringElem)->DotCount; break; }
+            case ID_CLUSTER_3: { DataCount = static_cast<const TCluster_3*>(ClusteringElem)->DataCount; DotCount = static_cast<const TCluster_3*>(ClusteringElem)->DotCount; break; }
+            case ID_CLUSTER_4: { DataCount = static_cast<const TCluster_4*>(ClusteringElem)->DataCount; DotCount = static_cast<const TCluster_4*>(ClusteringElem)->DotCount; break; }
+
+            default: { DataCount = 0; DotCount = 0; break; }
+        }
+    }
+
+    // Remove the member with the key from the map of members (Member - nullptr) or add the member with the key (false - the key is occupied)
+    template <typename Type> bool Change_Member(std::map<TCoordKey, const Type*>& MapMember, const TCoordKey& Key, const TClusteringElem* const Member)
+    {
+        if (!Member)
+            return MapMember.erase(Key) > 0;
+
+        return MapMember.emplace(Key, static_cast<const Type*>(Member)).second;
+    }
+
+    /* Remove the member of the specified id with the key from the cluster (Member - nullptr) or add the member with the key (false -
+    the key is occupied). Clusters are owned by non-constant sets, so their members can be changed. */
+    bool Change_Member(const TClusteringElem* const Cluster, const uint16_t MemberId, const TCoordKey& Key, const TClusteringElem* const Member)
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TClusteringElem* const cluster = const_cast<TClusteringElem*>(Cluster);
 
-        if (it != MapClusterizator.end())
+        switch (Cluster->Get_ClusteringElem_Id())
         {
-            TClusterizator& clusterizator = it->second;
+            case ID_CLUSTER_1:
+                return Change_Member(static_cast<TCluster_1*>(cluster)->MapDot, Key, Member);
+
+            case ID_CLUSTER_2:
+            {
+                TCluster_2* const c2 = static_cast<TCluster_2*>(cluster);
 
-            clusterizator.Clear(); // clear all data
+                return MemberId == ID_DOT ? Change_Member(c2->MapDot, Key, Member) : Change_Member(c2->MapCluster_1, Key, Member);
+            }
 
-            if (Address_Of_Data_Arr) // array specified
+            case ID_CLUSTER_3:
             {
-                for (uint32_t i = 0; i < ArrSize; ++i)
-                    clusterizator.MapDot.emplace(TCoordKey(X_Arr[i], Y_Arr[i]), new TDot(X_Arr[i], Y_Arr[i], (*Address_Of_Data_Arr)[i]));
+                TCluster_3* const c3 = static_cast<TCluster_3*>(cluster);
+
+                switch (MemberId)
+                {
+                    case ID_DOT:       return Change_Member(c3->MapDot, Key, Member);
+                    case ID_CLUSTER_1: return Change_Member(c3->MapCluster_1, Key, Member);
+                    default:           return Change_Member(c3->MapCluster_2, Key, Member);
+                }
             }
-            else // no array
+
+            case ID_CLUSTER_4:
             {
-                for (uint32_t i = 0; i < ArrSize; ++i)
-                    clusterizator.MapDot.emplace(TCoordKey(X_Arr[i], Y_Arr[i]), new TDot(X_Arr[i], Y_Arr[i]));
+                TCluster_4* const c4 = static_cast<TCluster_4*>(cluster);
+
+                switch (MemberId)
+                {
+                    case ID_DOT:       return Change_Member(c4->MapDot, Key, Member);
+                    case ID_CLUSTER_1: return Change_Member(c4->MapCluster_1, Key, Member);
+                    case ID_CLUSTER_2: return Change_Member(c4->MapCluster_2, Key, Member);
+                    default:           return Change_Member(c4->MapCluster_3, Key, Member);
+                }
             }
 
-            return 0;
+            default: return false;
         }
     }
 
-    return 1;
-}
+    // Add all members of the map to the array (members are owned by non-constant sets of their levels)
+    template <typename Type> void Collect_Members(const std::map<TCoordKey, const Type*>& MapMember, std::vector<TClusteringElem*>& VecMember)
+    {
+        for (const auto& member : MapMember)
+            VecMember.push_back(const_cast<Type*>(member.second));
+    }
 
-// Add single dot
-int32_t NS_Clustering::Clusterizator_Add_Dot(const uint32_t ClusterizatorId, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress)
-{
-    if (ClusterizatorId > 0)
+    // Add the clustering element of a lower level to the cluster_2..4 without calculating its center
+    void Add_Member(const TClusteringElem* const Cluster, TClusteringElem* const Member) noexcept
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TClusteringElem* const cluster = const_cast<TClusteringElem*>(Cluster);
 
-        if (it != MapClusterizator.end())
+        switch (Cluster->Get_ClusteringElem_Id())
         {
-            TMapDot&           map_dot  = it->second.MapDot;              // dots
-            TMapDot::iterator  dot      = map_dot.find(TCoordKey(X, Y));  // find dot with the specified coordinates
+            case ID_CLUSTER_2: { static_cast<TCluster_2*>(cluster)->Add_ClusteringElem(Member, false); break; }
+            case ID_CLUSTER_3: { static_cast<TCluster_3*>(cluster)->Add_ClusteringElem(Member, false); break; }
+            case ID_CLUSTER_4: { static_cast<TCluster_4*>(cluster)->Add_ClusteringElem(Member, false); break; }
+            default: break;
+        }
+    }
 
-            if (dot == map_dot.end()) // not found
-            {
-                // Create it
-                if (Address_Of_Data) // data for dot
-                    dot = map_dot.emplace(TCoordKey(X, Y), new TDot(X, Y, *Address_Of_Data)).first;
-                else // no data for dot
-                    dot = map_dot.emplace(TCoordKey(X, Y), new TDot(X, Y)).first;
-            }
-            else // found
-            {
-                if (Address_Of_Data) // data for dot
-                    dot->second->SetData.insert(*Address_Of_Data); // add data to the dataset in the dot
-            }
+    // Can the cluster contain the dot
+    inline bool Can_Contain(const TCluster_1& Cluster, const TDot* const Dot) noexcept { return Cluster.Check_Dot(Dot); }
+    inline bool Can_Contain(const TCluster_2& Cluster, const TDot* const Dot) noexcept { return Cluster.Check_ClusteringElem(Dot); }
+    inline bool Can_Contain(const TCluster_3& Cluster, const TDot* const Dot) noexcept { return Cluster.Check_ClusteringElem(Dot); }
+    inline bool Can_Contain(const TCluster_4& Cluster, const TDot* const Dot) noexcept { return Cluster.Check_ClusteringElem(Dot); }
 
-            Out_DotTagAddress = reinterpret_cast<uint64_t*>(&dot->second->Tag); // address of dots tag
+    // Find the nearest cluster of the set that can contain the dot, only centers not farther than Radius by X are checked
+    template <typename Type> Type* Find_Cluster_For_Dot(const std::map<TCoordKey, Type*>& MapCluster, const double Radius, const TDot* const Dot) noexcept
+    {
+        Type*   result        = nullptr;
+        double  min_distance  = 0.0;  // squared distance to the center of the found cluster
 
-            return 0;
+        for (auto cit = MapCluster.lower_bound(TCoordKey(Dot->X - Radius, Dot->Y - Radius)), cend = MapCluster.cend(); cit != cend && cit->first.X <= Dot->X + Radius; ++cit)
+        {
+            const double  dx        = static_cast<double>(cit->first.X) - Dot->X;
+            const double  dy        = static_cast<double>(cit->first.Y) - Dot->Y;
+            const double  distance  = dx * dx + dy * dy;
+
+            if ((!result || distance < min_distance) && Can_Contain(*cit->second, Dot))
+            {
+                result        = cit->second;
+                min_distance  = distance;
+            }
         }
+
+        return result;
     }
 
-    return 1;
-}
+    // Remove the cluster with the key from the set and the dense array of its level and delete it
+    template <typename Type> void Delete_Cluster(std::map<TCoordKey, Type*>& MapCluster, std::vector<Type*>& VecCluster, Type* const Cluster, const TCoordKey& Key) noexcept
+    {
+        MapCluster.erase(Key);
 
-// Create set of clusters_1
-int32_t NS_Clustering::Clusterizator_Create_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1) noexcept
-{
-    if (ClusterizatorId > 0)
+        if (Cluster->Index != INDEX_NONE)
+            Unindex_ClusteringElem(Cluster, VecCluster); // the last cluster takes the index
+
+        delete Cluster;
+    }
+
+    /* Changes of clusters after dots are added to them or removed from them without creating the clusters again. Clusters whose
+    members are changed are collected by levels, then Apply deletes the ones that are left with fewer than two members (their
+    members are given to the cluster that contained them or join the nearest clusters) and moves the rest to their new centers,
+    so the changes go up to the clusters that contain them. */
+    class TClusterRefresh
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+    private:
+        TClusterizator& Clusterizator;
+
+        std::vector<const TClusteringElem*>          VecChanged[4];  // clusters_1..4 whose members are changed
+        std::unordered_set<const TClusteringElem*>   SetShrunk;      // clusters that lost a member and have fewer than two
+        std::unordered_set<const TClusteringElem*>   SetDeleted;     // deleted clusters that may remain in VecChanged
+
+        // Remember that the members of the cluster are changed
+        void Changed(const TClusteringElem* const Cluster)
+        {
+            VecChanged[Cluster->Get_ClusteringElem_Id() - ID_CLUSTER_1].push_back(Cluster);
+        }
 
-        if (it != MapClusterizator.end())
+        // Remove the member with the key from the cluster that contains it
+        void Remove_From_Parent(const TClusteringElem* const Member, const TCoordKey& Key)
         {
-            Create_Clusters_1(it->second.MapDot, it->second.MapCluster_1, static_cast<bool>(SingleDot_To_Cluster_1));
+            const TClusteringElem* const parent = Member->Parent;
 
-            return 0;
+            Change_Member(parent, Member->Get_ClusteringElem_Id(), Key, nullptr);
+
+            if (Get_Member_Count(parent) < 2)
+                SetShrunk.insert(parent);
+
+            Changed(parent);
         }
+
+        /* Delete the cluster whose key in the sets is Key. Its members are given to the cluster that contained it, otherwise they
+        become free and free dots join the nearest clusters that can contain them. */
+        void Drop(const TClusteringElem* const Cluster, const TCoordKey& Key)
+        {
+            const TClusteringElem* const   parent  = Cluster->Parent;
+            std::vector<TClusteringElem*>  vec_member;
+
+            if (parent)
+            {
+                std::size_t  data_count  = 0;
+                std::size_t  dot_count   = 0;
+
+                Get_Counts(Cluster, data_count, dot_count);
+                Change_Counts_Of_Parents(Cluster, -static_cast<std::ptrdiff_t>(data_count), -static_cast<std::ptrdiff_t>(dot_count));
+                Remove_From_Parent(Cluster, Key);
+            }
+
+            SetShrunk.erase(Cluster);
+            SetDeleted.insert(Cluster);
+
+            switch (Cluster->Get_ClusteringElem_Id())
+            {
+                case ID_CLUSTER_1:
+                {
+                    TCluster_1* const c1 = static_cast<TCluster_1*>(const_cast<TClusteringElem*>(Cluster));
+
+                    Collect_Members(c1->MapDot, vec_member);
+                    Delete_Cluster(Clusterizator.MapCluster_1, Clusterizator.VecCluster_1, c1, Key);
+                    break;
+                }
+
+                case ID_CLUSTER_2:
+                {
+                    TCluster_2* const c2 = static_cast<TCluster_2*>(const_cast<TClusteringElem*>(Cluster));
+
+                    Collect_Members(c2->MapDot, vec_member);
+                    Collect_Members(c2->MapCluster_1, vec_member);
+                    Delete_Cluster(Clusterizator.MapCluster_2, Clusterizator.VecCluster_2, c2, Key);
+                    break;
+                }
+
+                case ID_CLUSTER_3:
+                {
+                    TCluster_3* const c3 = static_cast<TCluster_3*>(const_cast<TClusteringElem*>(Cluster));
+
+                    Collect_Members(c3->MapDot, vec_member);
+                    Collect_Members(c3->MapCluster_1, vec_member);
+                    Collect_Members(c3->MapCluster_2, vec_member);
+                    Delete_Cluster(Clusterizator.MapCluster_3, Clusterizator.VecCluster_3, c3, Key);
+                    break;
+                }
+
+                case ID_CLUSTER_4:
+                {
+                    TCluster_4* const c4 = static_cast<TCluster_4*>(const_cast<TClusteringElem*>(Cluster));
+
+                    Collect_Members(c4->MapDot, vec_member);
+                    Collect_Members(c4->MapCluster_1, vec_member);
+                    Collect_Members(c4->MapCluster_2, vec_member);
+                    Collect_Members(c4->MapCluster_3, vec_member);
+                    Delete_Cluster(Clusterizator.MapCluster_4, Clusterizator.VecCluster_4, c4, Key);
+                    break;
+                }
+
+                default: break;
+            }
+
+            for (TClusteringElem* const member : vec_member)
+            {
+                member->InCluster  = false;
+                member->Parent     = nullptr;
+
+                if (parent) // the cluster that contained the deleted one takes its members and their counts back
+                {
+                    std::size_t  data_count  = 0;
+                    std::size_t  dot_count   = 0;
+
+                    Add_Member(parent, member);
+                    Get_Counts(member, data_count, dot_count);
+                    Change_Counts_Of_Parents(parent, static_cast<std::ptrdiff_t>(data_count), static_cast<std::ptrdiff_t>(dot_count));
+                }
+                else if (member->Get_ClusteringElem_Id() == ID_DOT)
+                    Admit(static_cast<TDot*>(member));
+            }
+        }
+
+        /* Move the cluster from the key to its center in the set of its level. If the center is occupied, the cluster there
+        absorbs it (as the builders do), the absorbed cluster leaves the cluster that contained it, and the result is moved again.
+        The cluster that contains the result gets the new key of the member. */
+        template <typename Type> void Move(std::map<TCoordKey, Type*>& MapCluster, std::vector<Type*>& VecCluster, Type* Cluster, TCoordKey Key, void (Type::*Eat_Cluster)(Type*&))
+        {
+            MapCluster.erase(Key);
+
+            auto result = MapCluster.emplace(TCoordKey(Cluster->X, Cluster->Y), Cluster);
+
+            while (!result.second) // center is already occupied
+            {
+                Type* const      existing      = result.first->second;
+                const TCoordKey  existing_key  = result.first->first;
+                std::size_t      data_count    = 0;
+                std::size_t      dot_count     = 0;
+
+                // Data of the absorbed cluster moves from the clusters that contain it to the clusters that contain the existing one
+                Get_Counts(Cluster, data_count, dot_count);
+
+                if (Cluster->Parent)
+                {
+                    Change_Counts_Of_Parents(Cluster, -static_cast<std::ptrdiff_t>(data_count), -static_cast<std::ptrdiff_t>(dot_count));
+                    Remove_From_Parent(Cluster, Key);
+                }
+
+                Change_Counts_Of_Parents(existing, static_cast<std::ptrdiff_t>(data_count), static_cast<std::ptrdiff_t>(dot_count));
+
+                if (Cluster->Index != INDEX_NONE)
+                    Unindex_ClusteringElem(Cluster, VecCluster); // the last cluster takes the index
+
+                SetShrunk.erase(Cluster);
+                SetDeleted.insert(Cluster);
+
+                MapCluster.erase(result.first);     // the center of the existing cluster will change
+                (existing->*Eat_Cluster)(Cluster);  // absorb the moved cluster
+
+                Cluster  = existing;
+                Key      = existing_key;
+                result   = MapCluster.emplace(TCoordKey(Cluster->X, Cluster->Y), Cluster);
+            }
+
+            // The cluster that contains it has the new key of the member, so its center is changed too
+            if (Cluster->Parent && TCoordKey(Cluster->X, Cluster->Y) != Key)
+            {
+                Change_Member(Cluster->Parent, Cluster->Get_ClusteringElem_Id(), Key, nullptr);
+                Change_Member(Cluster->Parent, Cluster->Get_ClusteringElem_Id(), TCoordKey(Cluster->X, Cluster->Y), Cluster);
+                Changed(Cluster->Parent);
+            }
+        }
+
+        // Calculate the new center of the cluster and move it there in the sets
+        void Set_Center(const TClusteringElem* const Cluster)
+        {
+            TClusteringElem* const  cluster  = const_cast<TClusteringElem*>(Cluster);
+            const TCoordKey         key(cluster->X, cluster->Y);
+
+            switch (cluster->Get_ClusteringElem_Id())
+            {
+                case ID_CLUSTER_1: { static_cast<TCluster_1*>(cluster)->Set_Center(); break; }
+                case ID_CLUSTER_2: { static_cast<TCluster_2*>(cluster)->Set_Center(); break; }
+                case ID_CLUSTER_3: { static_cast<TCluster_3*>(cluster)->Set_Center(); break; }
+                case ID_CLUSTER_4: { static_cast<TCluster_4*>(cluster)->Set_Center(); break; }
+                default: break;
+            }
+
+            if (TCoordKey(cluster->X, cluster->Y) == key)
+                return;
+
+            switch (cluster->Get_ClusteringElem_Id())
+            {
+                case ID_CLUSTER_1: { Move(Clusterizator.MapCluster_1, Clusterizator.VecCluster_1, static_cast<TCluster_1*>(cluster), key, &TCluster_1::Eat_Cluster_1); break; }
+                case ID_CLUSTER_2: { Move(Clusterizator.MapCluster_2, Clusterizator.VecCluster_2, static_cast<TCluster_2*>(cluster), key, &TCluster_2::Eat_Cluster_2); break; }
+                case ID_CLUSTER_3: { Move(Clusterizator.MapCluster_3, Clusterizator.VecCluster_3, static_cast<TCluster_3*>(cluster), key, &TCluster_3::Eat_Cluster_3); break; }
+                case ID_CLUSTER_4: { Move(Clusterizator.MapCluster_4, Clusterizator.VecCluster_4, static_cast<TCluster_4*>(cluster), key, &TCluster_4::Eat_Cluster_4); break; }
+                default: break;
+            }
+        }
+
+    public:
+        explicit TClusterRefresh(TClusterizator& Clusterizator_) noexcept :
+            Clusterizator(Clusterizator_)
+        {}
+
+        // Remove the dot from the cluster that contains it, the dot becomes free
+        void Detach(TDot* const Dot)
+        {
+            if (!Dot->Parent)
+                return;
+
+            Change_Counts_Of_Parents(Dot, -static_cast<std::ptrdiff_t>(Dot->Get_Count()), -1);
+            Remove_From_Parent(Dot, TCoordKey(Dot->X, Dot->Y));
+
+            Dot->InCluster  = false;
+            Dot->Parent     = nullptr;
+        }
+
+        // Add the free dot to the nearest cluster of the lowest level that can contain it (false - there is no such cluster)
+        bool Admit(TDot* const Dot)
+        {
+            if (Dot->InCluster || !Dot->Selected)
+                return false;
+
+            TClusteringElem* cluster = nullptr;
+
+            if (TCluster_1* const c1 = Find_Cluster_For_Dot(Clusterizator.MapCluster_1, Cluster_1_Radius + AdditionalRadiusValue, Dot))
+            {
+                c1->Add_Dot(Dot, false);
+                cluster = c1;
+            }
+            else if (TCluster_2* const c2 = Find_Cluster_For_Dot(Clusterizator.MapCluster_2, Cluster_2_Radius + AdditionalRadiusValue, Dot))
+            {
+                c2->Add_ClusteringElem(Dot, false);
+                cluster = c2;
+            }
+            else if (TCluster_3* const c3 = Find_Cluster_For_Dot(Clusterizator.MapCluster_3, Cluster_3_Radius + AdditionalRadiusValue, Dot))
+            {
+                c3->Add_ClusteringElem(Dot, false);
+                cluster = c3;
+            }
+            else if (TCluster_4* const c4 = Find_Cluster_For_Dot(Clusterizator.MapCluster_4, Cluster_4_Radius + AdditionalRadiusValue, Dot))
+            {
+                c4->Add_ClusteringElem(Dot, false);
+                cluster = c4;
+            }
+
+            if (!cluster)
+                return false;
+
+            Change_Counts_Of_Parents(cluster, static_cast<std::ptrdiff_t>(Dot->Get_Count()), 1); // the cluster itself counted the dot
+            Changed(cluster);
+
+            return true;
+        }
+
+        /* Delete clusters with fewer than two members and move the rest to their new centers, from clusters_1 to clusters_4. Dots
+        of deleted clusters may join clusters of the levels that are already processed, so the levels are processed again from
+        clusters_1 until no cluster is changed. */
+        void Apply(void)
+        {
+            std::vector<const TClusteringElem*> vec_changed;
+
+            for (std::size_t level = 0; level < 4; )
+            {
+                if (VecChanged[level].empty())
+                {
+                    ++level;
+                    continue;
+                }
+
+                vec_changed.clear();
+                vec_changed.swap(VecChanged[level]);
+
+                std::sort(vec_changed.begin(), vec_changed.end());
+                vec_changed.erase(std::unique(vec_changed.begin(), vec_changed.end()), vec_changed.end());
+
+                for (const TClusteringElem* const cluster : vec_changed)
+                {
+                    if (SetDeleted.count(cluster)) // absorbed or deleted after it was changed
+                        continue;
+
+                    const std::size_t member_count = Get_Member_Count(cluster);
+
+                    if (member_count == 0 || (member_count < 2 && SetShrunk.count(cluster)))
+                        Drop(cluster, TCoordKey(cluster->X, cluster->Y));
+                    else
+                        Set_Center(cluster);
+                }
+
+                level = 0;
+            }
+
+            SetShrunk.clear();
+            SetDeleted.clear();
+        }
+    };
+}
+
+// Add timed dots
+void NS_Clustering::TClusterizator::Append_Timed_Dots(const uint32_t ArrSize, const double* const X_Arr, const double* const Y_Arr, const int64_t* const Time_Arr, const uint64_t* const Data_Arr)
+{
+    TagIndex_Actual = false; // new dots may have tags (before the changes, so that the views are not left actual on failure)
+    Views_Changed();
+
+    TClusterRefresh refresh(*this);
+
+    for (uint32_t i = 0; i < ArrSize; ++i)
+    {
+        if (!Coord_Is_Valid(X_Arr[i]) || !Coord_Is_Valid(Y_Arr[i]))
+            continue;
+
+        const TCoordKey    key(X_Arr[i], Y_Arr[i]);
+        TMapDot::iterator  it = MapDot.lower_bound(key);
+
+        if (it == MapDot.end() || key < it->first) // new dot, it is timed
+        {
+            std::unique_ptr<TDot> dot(Data_Arr ? new TDot(X_Arr[i], Y_Arr[i], Data_Arr[i]) : new TDot(X_Arr[i], Y_Arr[i]));
+
+            it = MapDot.emplace_hint(it, key, dot.get());
+            dot.release(); // the dot is owned by the set
+
+            Index_ClusteringElem(it->second, VecDot); // dot gets the next index
+            TimeWindow.Set_Time(it->second, Time_Arr[i]);
+            refresh.Admit(it->second); // dot joins the nearest existing cluster that can contain it
+        }
+        else // existing dot, it receives the data and remains timed or not
+        {
+            TDot* const dot = it->second;
+
+            // The amount of data of the clusters that contain the dot is also changed
+            if (Data_Arr && dot->SetData.insert(Data_Arr[i]))
+                Change_Counts_Of_Parents(dot, 1, 0);
+
+            if (TimeWindow.Is_Timed(dot))
+                TimeWindow.Set_Time(dot, Time_Arr[i]);
+        }
+    }
+
+    refresh.Apply(); // clusters that received dots are moved to their new centers
+}
+
+// Delete timed dots whose latest time is earlier than Min_Time
+uint32_t NS_Clustering::TClusterizator::Expire_Dots(const int64_t Min_Time)
+{
+    std::vector<TDot*> vec_expired;
+
+    TimeWindow.Take_Expired(Min_Time, vec_expired);
+
+    if (vec_expired.empty())
+        return 0;
+
+    TClusterRefresh refresh(*this);
+
+    for (TDot* const dot : vec_expired)
+    {
+        refresh.Detach(dot); // the clusters that contain it lose its data
+        MapDot.erase(TCoordKey(dot->X, dot->Y));
+        Unindex_ClusteringElem(dot, VecDot); // the last dot takes the index
+        delete dot;
+    }
+
+    refresh.Apply(); // clusters that are left with fewer than two members are deleted, the rest are moved to their new centers
+
+    TagIndex_Actual = false; // dots with tags may be deleted
+    Views_Changed();
+
+    return static_cast<uint32_t>(vec_expired.size());
+}
+
+// Get the amount of data
+std::size_t NS_Clustering::TClusterizator::Get_Count(const uint16_t ClusteringElemId, bool All) const noexcept
+{
+    std::size_t result = 0;
+
+    if (All) // all clustering elements
+    {
+        result = ClusteringElem_Get_Count(MapDot) + ClusteringElem_Get_Count(MapCluster_1) + ClusteringElem_Get_Count(MapCluster_2) +
+            ClusteringElem_Get_Count(MapCluster_3) + ClusteringElem_Get_Count(MapCluster_4);
+    }
+    else // specified clustering elements
+    {
+        switch (ClusteringElemId)
+        {
+            case ID_DOT:       { result = ClusteringElem_Get_Count(MapDot); break; }
+            case ID_CLUSTER_1: { result = ClusteringElem_Get_Count(MapCluster_1); break; }
+            case ID_CLUSTER_2: { result = ClusteringElem_Get_Count(MapCluster_2); break; }
+            case ID_CLUSTER_3: { result = ClusteringElem_Get_Count(MapCluster_3); break; }
+            case ID_CLUSTER_4: { result = ClusteringElem_Get_Count(MapCluster_4); break; }
+
+            default: break;
+        }
+    }
+
+    return result;
+}
+
+// Find clustering element of the specified id by its coordinates
+const NS_Clustering::TClusteringElem* NS_Clustering::TClusterizator::Find_ClusteringElem(const uint16_t ClusteringElemId, const double X, const double Y) const noexcept
+{
+    switch (ClusteringElemId)
+    {
+        case ID_DOT:       return NS_Clustering::Find_ClusteringElem(MapDot, X, Y);
+        case ID_CLUSTER_1: return NS_Clustering::Find_ClusteringElem(MapCluster_1, X, Y);
+        case ID_CLUSTER_2: return NS_Clustering::Find_ClusteringElem(MapCluster_2, X, Y);
+        case ID_CLUSTER_3: return NS_Clustering::Find_ClusteringElem(MapCluster_3, X, Y);
+        case ID_CLUSTER_4: return NS_Clustering::Find_ClusteringElem(MapCluster_4, X, Y);
+
+        default: return nullptr;
+    }
+}
+
+// Find clustering element of the specified id by its index
+const NS_Clustering::TClusteringElem* NS_Clustering::TClusterizator::Find_ClusteringElem(const uint16_t ClusteringElemId, const uint32_t Index) const noexcept
+{
+    switch (ClusteringElemId)
+    {
+        case ID_DOT:       return NS_Clustering::Find_ClusteringElem(VecDot, Index);
+        case ID_CLUSTER_1: return NS_Clustering::Find_ClusteringElem(VecCluster_1, Index);
+        case ID_CLUSTER_2: return NS_Clustering::Find_ClusteringElem(VecCluster_2, Index);
+        case ID_CLUSTER_3: return NS_Clustering::Find_ClusteringElem(VecCluster_3, Index);
+        case ID_CLUSTER_4: return NS_Clustering::Find_ClusteringElem(VecCluster_4, Index);
+
+        default: return nullptr;
+    }
+}
+
+// Get the index of tags, it is rebuilt if it is not actual
+const NS_Clustering::TTagIndex& NS_Clustering::TClusterizator::Get_TagIndex(void)
+{
+    if (!TagIndex_Actual)
+    {
+        TagIndex.Build(MapDot, MapCluster_1, MapCluster_2, MapCluster_3, MapCluster_4);
+        TagIndex_Actual = true;
+    }
+
+    return TagIndex;
+}
+
+// Mark arrays of views of all clustering elements as not actual
+void NS_Clustering::TClusterizator::Views_Changed(void) noexcept
+{
+    ArraysDot.Actual        = false;
+    ArraysCluster_1.Actual  = false;
+    ArraysCluster_2.Actual  = false;
+    ArraysCluster_3.Actual  = false;
+    ArraysCluster_4.Actual  = false;
+}
+
+// Get the view of arrays of clustering elements of the specified id
+bool NS_Clustering::TClusterizator::Get_View(const uint16_t ClusteringElemId, TClusteringElemView& View)
+{
+    TClusteringElemArrays* arrays = nullptr;
+
+    switch (ClusteringElemId)
+    {
+        case ID_DOT:       { arrays = &ArraysDot; if (!arrays->Actual) arrays->Build(VecDot); break; }
+        case ID_CLUSTER_1: { arrays = &ArraysCluster_1; if (!arrays->Actual) arrays->Build(VecCluster_1); break; }
+        case ID_CLUSTER_2: { arrays = &ArraysCluster_2; if (!arrays->Actual) arrays->Build(VecCluster_2); break; }
+        case ID_CLUSTER_3: { arrays = &ArraysCluster_3; if (!arrays->Actual) arrays->Build(VecCluster_3); break; }
+        case ID_CLUSTER_4: { arrays = &ArraysCluster_4; if (!arrays->Actual) arrays->Build(VecCluster_4); break; }
+
+        default: return false;
+    }
+
+    View = arrays->Get_View();
+
+    return true;
+}
+
+// Get the memory of the clusterizator in bytes
+uint64_t NS_Clustering::TClusterizator::Get_Memory_Usage(TMemoryUsage* const Usage_Arr) const noexcept
+{
+    TMemoryUsage usage[5] =
+    {
+        NS_Clustering::Get_Memory_Usage(MapDot, VecDot, ArraysDot),
+        NS_Clustering::Get_Memory_Usage(MapCluster_1, VecCluster_1, ArraysCluster_1),
+        NS_Clustering::Get_Memory_Usage(MapCluster_2, VecCluster_2, ArraysCluster_2),
+        NS_Clustering::Get_Memory_Usage(MapCluster_3, VecCluster_3, ArraysCluster_3),
+        NS_Clustering::Get_Memory_Usage(MapCluster_4, VecCluster_4, ArraysCluster_4)
+    };
+
+    // Blocks of datasets belong to dots
+    usage[ID_DOT].Member_Bytes  += DataArena.Get_Memory_Usage();
+    usage[ID_DOT].Total_Bytes   += DataArena.Get_Memory_Usage();
+
+    // The clusterizator itself with its node in the registry and the control block of shared_ptr, the index of tags and times of dots
+    uint64_t result = sizeof(TClusterizatorRegistry::TMap::value_type) + Map_Node_Overhead + Shared_Block_Overhead + sizeof(TClusterizator) + TagIndex.Get_Memory_Usage() +
+        TimeWindow.Get_Memory_Usage();
+
+    for (uint16_t id = ID_DOT; id <= ID_CLUSTER_4; ++id)
+        result += usage[id].Total_Bytes;
+
+    if (Usage_Arr)
+        std::copy(usage, usage + 5, Usage_Arr);
+
+    return result;
+}
+
+namespace NS_Clustering
+{
+    // Visit clustering elements that are directly contained in the cluster
+    template <typename Visitor> void For_Each_Member(const TCluster_1& Cluster, Visitor&& Visit)
+    {
+        for (const auto& dot : Cluster.MapDot) Visit(dot.second);
+    }
+
+    template <typename Visitor> void For_Each_Member(const TCluster_2& Cluster, Visitor&& Visit)
+    {
+        for (const auto& dot : Cluster.MapDot) Visit(dot.second);
+        for (const auto& c1 : Cluster.MapCluster_1) Visit(c1.second);
+    }
+
+    template <typename Visitor> void For_Each_Member(const TCluster_3& Cluster, Visitor&& Visit)
+    {
+        for (const auto& dot : Cluster.MapDot) Visit(dot.second);
+        for (const auto& c1 : Cluster.MapCluster_1) Visit(c1.second);
+        for (const auto& c2 : Cluster.MapCluster_2) Visit(c2.second);
+    }
+
+    template <typename Visitor> void For_Each_Member(const TCluster_4& Cluster, Visitor&& Visit)
+    {
+        for (const auto& dot : Cluster.MapDot) Visit(dot.second);
+        for (const auto& c1 : Cluster.MapCluster_1) Visit(c1.second);
+        for (const auto& c2 : Cluster.MapCluster_2) Visit(c2.second);
+        for (const auto& c3 : Cluster.MapCluster_3) Visit(c3.second);
+    }
+
+    // Does the clustering element or any clustering element inside it have the tag, by walking the clustering elements
+    bool Is_Have_Tag_Inside_By_Walk(const TClusteringElem* const ClusteringElem, const uint64_t Tag) noexcept
+    {
+        if (ClusteringElem->Tag == Tag)
+            return true;
+
+        bool found = false;
+        const auto visit = [Tag, &found](const TClusteringElem* const Member) { if (!found) found = Is_Have_Tag_Inside_By_Walk(Member, Tag); };
+
+        switch (ClusteringElem->Get_ClusteringElem_Id())
+        {
+            case ID_CLUSTER_1: For_Each_Member(*static_cast<const TCluster_1*>(ClusteringElem), visit); break;
+            case ID_CLUSTER_2: For_Each_Member(*static_cast<const TCluster_2*>(ClusteringElem), visit); break;
+            case ID_CLUSTER_3: For_Each_Member(*static_cast<const TCluster_3*>(ClusteringElem), visit); break;
+            case ID_CLUSTER_4: For_Each_Member(*static_cast<const TCluster_4*>(ClusteringElem), visit); break;
+            default: break;
+        }
+
+        return found;
+    }
+
+    // Write records to the file
+    template <typename Type> bool Write_Records(std::FILE* const File, const Type* const Arr, const std::size_t Count) noexcept
+    {
+        return Count == 0 || std::fwrite(Arr, sizeof(Type), Count, File) == Count;
+    }
+
+    // Write records of clusters of one level, the position of their first member is counted from MemberFirst
+    template <typename Type> bool Write_Snapshot_Clusters(std::FILE* const File, const std::vector<Type*>& VecCluster, uint64_t& MemberFirst) noexcept
+    {
+        for (const auto cluster : VecCluster)
+        {
+            TSnapshotCluster record = {};
+
+            record.X            = cluster->X;
+            record.Y            = cluster->Y;
+            record.R            = cluster->R;
+            record.Tag          = cluster->Tag;
+            record.DataCount    = cluster->DataCount;
+            record.DotCount     = cluster->DotCount;
+            record.MemberFirst  = MemberFirst;
+            record.InCluster    = cluster->InCluster ? 1 : 0;
+
+            For_Each_Member(*cluster, [&record](const TClusteringElem* const) { ++record.MemberSize; });
+
+            MemberFirst += record.MemberSize;
+
+            if (!Write_Records(File, &record, 1))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Write members of clusters of one level
+    template <typename Type> bool Write_Snapshot_Members(std::FILE* const File, const std::vector<Type*>& VecCluster) noexcept
+    {
+        bool result = true;
+
+        for (const auto cluster : VecCluster)
+        {
+            For_Each_Member(*cluster, [File, &result](const TClusteringElem* const ClusteringElem)
+            {
+                const TSnapshotMember member = { ClusteringElem->Get_ClusteringElem_Id(), ClusteringElem->Index };
+
+                result = result && Write_Records(File, &member, 1);
+            });
+        }
+
+        return result;
+    }
+
+    // Add member to the set of the cluster while loading (false - there is no such element or it is already in some cluster)
+    template <typename Type> bool Add_Snapshot_Member(std::map<TCoordKey, const Type*>& MapMember, const std::vector<Type*>& VecClusteringElem, const uint32_t Index, const TClusteringElem* const Cluster)
+    {
+        if (Index >= VecClusteringElem.size() || VecClusteringElem[Index]->Parent)
+            return false;
+
+        Type* const elem = VecClusteringElem[Index];
+
+        elem->Parent = Cluster;
+        MapMember.emplace_hint(MapMember.end(), TCoordKey(elem->X, elem->Y), elem); // members are saved in the order of the set
+
+        return true;
+    }
+
+    // Add member to the cluster while loading (false - the member is incorrect)
+    bool Add_Snapshot_Member(TCluster_1& Cluster, const TClusterizator& Clusterizator, const TSnapshotMember& Member)
+    {
+        switch (Member.ClusteringElemId)
+        {
+            case ID_DOT: return Add_Snapshot_Member(Cluster.MapDot, Clusterizator.VecDot, Member.Index, &Cluster);
+
+            default: return false;
+        }
+    }
+
+    bool Add_Snapshot_Member(TCluster_2& Cluster, const TClusterizator& Clusterizator, const TSnapshotMember& Member)
+    {
+        switch (Member.ClusteringElemId)
+        {
+            case ID_DOT:       return Add_Snapshot_Member(Cluster.MapDot, Clusterizator.VecDot, Member.Index, &Cluster);
+            case ID_CLUSTER_1: return Add_Snapshot_Member(Cluster.MapCluster_1, Clusterizator.VecCluster_1, Member.Index, &Cluster);
+
+            default: return false;
+        }
+    }
+
+    bool Add_Snapshot_Member(TCluster_3& Cluster, const TClusterizator& Clusterizator, const TSnapshotMember& Member)
+    {
+        switch (Member.ClusteringElemId)
+        {
+            case ID_DOT:       return Add_Snapshot_Member(Cluster.MapDot, Clusterizator.VecDot, Member.Index, &Cluster);
+            case ID_CLUSTER_1: return Add_Snapshot_Member(Cluster.MapCluster_1, Clusterizator.VecCluster_1, Member.Index, &Cluster);
+            case ID_CLUSTER_2: return Add_Snapshot_Member(Cluster.MapCluster_2, Clusterizator.VecCluster_2, Member.Index, &Cluster);
+
+            default: return false;
+        }
+    }
+
+    bool Add_Snapshot_Member(TCluster_4& Cluster, const TClusterizator& Clusterizator, const TSnapshotMember& Member)
+    {
+        switch (Member.ClusteringElemId)
+        {
+            case ID_DOT:       return Add_Snapshot_Member(Cluster.MapDot, Clusterizator.VecDot, Member.Index, &Cluster);
+            case ID_CLUSTER_1: return Add_Snapshot_Member(Cluster.MapCluster_1, Clusterizator.VecCluster_1, Member.Index, &Cluster);
+            case ID_CLUSTER_2: return Add_Snapshot_Member(Cluster.MapCluster_2, Clusterizator.VecCluster_2, Member.Index, &Cluster);
+            case ID_CLUSTER_3: return Add_Snapshot_Member(Cluster.MapCluster_3, Clusterizator.VecCluster_3, Member.Index, &Cluster);
+
+            default: return false;
+        }
+    }
+
+    // Create clusters of one level from their records while loading (false - the records are incorrect)
+    template <typename Type> bool Load_Snapshot_Clusters(
+        TClusterizator&                Clusterizator,
+        const TSnapshotCluster* const  Cluster_Arr,
+        const uint64_t                 ClusterCount,
+        const TSnapshotMember* const   Member_Arr,
+        const uint64_t                 MemberCount,
+        std::map<TCoordKey, Type*>&    MapCluster,
+        std::vector<Type*>&            VecCluster)
+    {
+        VecCluster.reserve(ClusterCount);
+
+        for (uint64_t i = 0; i < ClusterCount; ++i)
+        {
+            const TSnapshotCluster& record = Cluster_Arr[i];
+
+            if (record.MemberFirst > MemberCount || record.MemberSize > MemberCount - record.MemberFirst ||
+                !Coord_Is_Valid(record.X) || !Coord_Is_Valid(record.Y) || !Coord_Is_Valid(record.R))
+                return false;
+
+            Type* const cluster = new Type();
+
+            cluster->X          = To_Coord(record.X);
+            cluster->Y          = To_Coord(record.Y);
+            cluster->R          = To_Coord(record.R);
+            cluster->Tag        = record.Tag;
+            cluster->InCluster  = record.InCluster != 0;
+            cluster->DataCount  = static_cast<std::size_t>(record.DataCount);
+            cluster->DotCount   = static_cast<std::size_t>(record.DotCount);
+
+            const std::size_t size = MapCluster.size();
+
+            MapCluster.emplace_hint(MapCluster.end(), TCoordKey(cluster->X, cluster->Y), cluster); // clusters are saved in the order of the set
+
+            if (MapCluster.size() == size) // center is occupied
+            {
+                delete cluster;
+
+                return false;
+            }
+
+            Index_ClusteringElem(cluster, VecCluster);
+
+            for (uint64_t m = record.MemberFirst, last = record.MemberFirst + record.MemberSize; m < last; ++m)
+            {
+                if (!Add_Snapshot_Member(*cluster, Clusterizator, Member_Arr[m]))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Check that the section of records is inside the file and is aligned
+    bool Check_File_Section(const uint64_t FileSize, const uint64_t Offset, const uint64_t Count, const uint64_t RecordSize) noexcept
+    {
+        return Offset % 8 == 0 && Offset <= FileSize && Count <= (FileSize - Offset) / RecordSize;
+    }
+}
+
+// Does the clustering element or any clustering element inside it have the tag, by the index of tags if it is enabled
+bool NS_Clustering::TClusterizator::Is_Have_Tag_Inside(const TClusteringElem* const ClusteringElem, const uint64_t Tag) noexcept
+{
+    if (TagIndex_Enabled) // changes of tags are notified, so the index of tags is actual
+    {
+        try
+        {
+            return Get_TagIndex().Is_Have_Tag_Inside(ClusteringElem, Tag);
+        }
+        catch (...) {} // no memory for the index of tags, clustering elements are walked
+    }
+
+    return Is_Have_Tag_Inside_By_Walk(ClusteringElem, Tag);
+}
+
+// Save dots and all sets of clusters to the snapshot file
+bool NS_Clustering::TClusterizator::Save_Snapshot(const char* const FileName) const
+{
+    if (VecDot.size() != MapDot.size() || VecCluster_1.size() != MapCluster_1.size() || VecCluster_2.size() != MapCluster_2.size() ||
+        VecCluster_3.size() != MapCluster_3.size() || VecCluster_4.size() != MapCluster_4.size())
+        return false; // not all clustering elements are indexed
+
+    std::FILE* const file = std::fopen(FileName, "wb");
+
+    if (!file)
+        return false;
+
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 20); // write by large blocks
+
+    TSnapshotHeader header = {};
+
+    std::copy(Snapshot_Magic, Snapshot_Magic + sizeof(Snapshot_Magic), header.Magic);
+
+    header.Version          = Snapshot_Version;
+    header.HeaderSize       = sizeof(TSnapshotHeader);
+    header.DotCount         = VecDot.size();
+    header.ClusterCount[0]  = VecCluster_1.size();
+    header.ClusterCount[1]  = VecCluster_2.size();
+    header.ClusterCount[2]  = VecCluster_3.size();
+    header.ClusterCount[3]  = VecCluster_4.size();
+    header.DotOffset        = sizeof(TSnapshotHeader);
+
+    bool result = Write_Records(file, &header, 1); // header is rewritten at the end, when all positions are known
+
+    // Dots, their datasets follow them
+    for (auto cit = VecDot.cbegin(), cend = VecDot.cend(); result && cit != cend; ++cit)
+    {
+        TSnapshotDot record = {};
+
+        record.X          = (*cit)->X;
+        record.Y          = (*cit)->Y;
+        record.Tag        = (*cit)->Tag;
+        record.DataFirst  = header.DataCount;
+        record.DataSize   = static_cast<uint32_t>((*cit)->SetData.size());
+        record.InCluster  = (*cit)->InCluster ? 1 : 0;
+
+        header.DataCount += record.DataSize;
+
+        result = Write_Records(file, &record, 1);
+    }
+
+    header.DataOffset = header.DotOffset + header.DotCount * sizeof(TSnapshotDot);
+
+    for (auto cit = VecDot.cbegin(), cend = VecDot.cend(); result && cit != cend; ++cit)
+        result = Write_Records(file, (*cit)->SetData.cbegin(), (*cit)->SetData.size());
+
+    // Clusters of each level, their members follow them
+    header.ClusterOffset[0]  = header.DataOffset + header.DataCount * sizeof(uint64_t);
+    header.ClusterOffset[1]  = header.ClusterOffset[0] + header.ClusterCount[0] * sizeof(TSnapshotCluster);
+    header.ClusterOffset[2]  = header.ClusterOffset[1] + header.ClusterCount[1] * sizeof(TSnapshotCluster);
+    header.ClusterOffset[3]  = header.ClusterOffset[2] + header.ClusterCount[2] * sizeof(TSnapshotCluster);
+    header.MemberOffset      = header.ClusterOffset[3] + header.ClusterCount[3] * sizeof(TSnapshotCluster);
+
+    result = result &&
+        Write_Snapshot_Clusters(file, VecCluster_1, header.MemberCount) &&
+        Write_Snapshot_Clusters(file, VecCluster_2, header.MemberCount) &&
+        Write_Snapshot_Clusters(file, VecCluster_3, header.MemberCount) &&
+        Write_Snapshot_Clusters(file, VecCluster_4, header.MemberCount) &&
+        Write_Snapshot_Members(file, VecCluster_1) &&
+        Write_Snapshot_Members(file, VecCluster_2) &&
+        Write_Snapshot_Members(file, VecCluster_3) &&
+        Write_Snapshot_Members(file, VecCluster_4);
+
+    header.FileSize = header.MemberOffset + header.MemberCount * sizeof(TSnapshotMember);
+
+    result = result && std::fseek(file, 0, SEEK_SET) == 0 && Write_Records(file, &header, 1);
+    result = std::fclose(file) == 0 && result;
+
+    if (!result)
+        std::remove(FileName); // do not leave an incomplete snapshot
+
+    return result;
+}
+
+// Replace all data by the contents of the snapshot file
+bool NS_Clustering::TClusterizator::Load_Snapshot(const char* const FileName)
+{
+    std::unique_ptr<TClusterizator> loaded(new TClusterizator()); // the snapshot is checked while it is loaded here, partial data is freed with it
+
+    if (!loaded->Read_Snapshot(FileName))
+        return false;
+
+    Clear(); // clear all data
+
+    MapDot.swap(loaded->MapDot);
+    MapCluster_1.swap(loaded->MapCluster_1);
+    MapCluster_2.swap(loaded->MapCluster_2);
+    MapCluster_3.swap(loaded->MapCluster_3);
+    MapCluster_4.swap(loaded->MapCluster_4);
+    VecDot.swap(loaded->VecDot);
+    VecCluster_1.swap(loaded->VecCluster_1);
+    VecCluster_2.swap(loaded->VecCluster_2);
+    VecCluster_3.swap(loaded->VecCluster_3);
+    VecCluster_4.swap(loaded->VecCluster_4);
+    Snapshot.swap(loaded->Snapshot); // datasets of dots refer to it
+
+    return true;
+}
+
+// Load the contents of the snapshot file into the empty clusterizator
+bool NS_Clustering::TClusterizator::Read_Snapshot(const char* const FileName)
+{
+    std::unique_ptr<TMappedFile> file(new TMappedFile());
+
+    if (!file->Open(FileName) || file->Get_Size() < sizeof(TSnapshotHeader))
+        return false;
+
+    const uint8_t* const    data    = file->Get_Data();
+    const uint64_t          size    = file->Get_Size();
+    const TSnapshotHeader&  header  = *reinterpret_cast<const TSnapshotHeader*>(data);
+
+    // Check the header and that all sections are inside the file
+    if (!std::equal(Snapshot_Magic, Snapshot_Magic + sizeof(Snapshot_Magic), header.Magic) || header.Version != Snapshot_Version ||
+        header.HeaderSize != sizeof(TSnapshotHeader) || header.FileSize != size ||
+        !Check_File_Section(size, header.DotOffset, header.DotCount, sizeof(TSnapshotDot)) ||
+        !Check_File_Section(size, header.DataOffset, header.DataCount, sizeof(uint64_t)) ||
+        !Check_File_Section(size, header.ClusterOffset[0], header.ClusterCount[0], sizeof(TSnapshotCluster)) ||
+        !Check_File_Section(size, header.ClusterOffset[1], header.ClusterCount[1], sizeof(TSnapshotCluster)) ||
+        !Check_File_Section(size, header.ClusterOffset[2], header.ClusterCount[2], sizeof(TSnapshotCluster)) ||
+        !Check_File_Section(size, header.ClusterOffset[3], header.ClusterCount[3], sizeof(TSnapshotCluster)) ||
+        !Check_File_Section(size, header.MemberOffset, header.MemberCount, sizeof(TSnapshotMember)) ||
+        header.DotCount >= INDEX_NONE)
+        return false;
+
+    const TSnapshotDot* const     dot_arr     = reinterpret_cast<const TSnapshotDot*>(data + header.DotOffset);
+    const uint64_t* const         value_arr   = reinterpret_cast<const uint64_t*>(data + header.DataOffset);
+    const TSnapshotMember* const  member_arr  = reinterpret_cast<const TSnapshotMember*>(data + header.MemberOffset);
+
+    // Dots, datasets with several values refer to the mapped file
+    VecDot.reserve(header.DotCount);
+
+    for (uint64_t i = 0; i < header.DotCount; ++i)
+    {
+        const TSnapshotDot& record = dot_arr[i];
+
+        if (record.DataFirst > header.DataCount || record.DataSize > header.DataCount - record.DataFirst ||
+            !Coord_Is_Valid(record.X) || !Coord_Is_Valid(record.Y)) // the snapshot can be saved by the library with other coordinates
+        {
+            Clear();
+
+            return false;
+        }
+
+        TDot* const dot = new TDot(record.X, record.Y);
+
+        dot->Tag        = record.Tag;
+        dot->InCluster  = record.InCluster != 0;
+
+        if (record.DataSize == 1)
+            dot->SetData.insert(value_arr[record.DataFirst]);
+        else if (record.DataSize > 1)
+            dot->SetData.Refer(value_arr + record.DataFirst, record.DataSize);
+
+        if (!MapDot.emplace(TCoordKey(dot->X, dot->Y), dot).second) // coordinates are occupied
+        {
+            delete dot;
+            Clear();
+
+            return false;
+        }
+
+        Index_ClusteringElem(dot, VecDot);
+    }
+
+    // Clusters from the lowest level, so that their members already exist
+    const bool result =
+        Load_Snapshot_Clusters(*this, reinterpret_cast<const TSnapshotCluster*>(data + header.ClusterOffset[0]), header.ClusterCount[0], member_arr, header.MemberCount, MapCluster_1, VecCluster_1) &&
+        Load_Snapshot_Clusters(*this, reinterpret_cast<const TSnapshotCluster*>(data + header.ClusterOffset[1]), header.ClusterCount[1], member_arr, header.MemberCount, MapCluster_2, VecCluster_2) &&
+        Load_Snapshot_Clusters(*this, reinterpret_cast<const TSnapshotCluster*>(data + header.ClusterOffset[2]), header.ClusterCount[2], member_arr, header.MemberCount, MapCluster_3, VecCluster_3) &&
+        Load_Snapshot_Clusters(*this, reinterpret_cast<const TSnapshotCluster*>(data + header.ClusterOffset[3]), header.ClusterCount[3], member_arr, header.MemberCount, MapCluster_4, VecCluster_4);
+
+    if (!result)
+    {
+        Clear();
+
+        return false;
+    }
+
+    Snapshot = std::move(file); // datasets of dots refer to it
+
+    return true;
+}
+
+// Load dots from the columnar point file
+bool NS_Clustering::TClusterizator::Load_Point_File(const char* const FileName, const bool Append, uint64_t& Out_RejectedCount)
+{
+    TMappedFile file;
+
+    Out_RejectedCount = 0;
+
+    if (!file.Open(FileName) || file.Get_Size() < sizeof(TPointFileHeader))
+        return false;
+
+    const uint8_t* const     data    = file.Get_Data();
+    const uint64_t           size    = file.Get_Size();
+    const TPointFileHeader&  header  = *reinterpret_cast<const TPointFileHeader*>(data);
+
+    // Check the header and that all arrays are inside the file
+    if (!std::equal(Point_File_Magic, Point_File_Magic + sizeof(Point_File_Magic), header.Magic) || header.Version != Point_File_Version ||
+        header.HeaderSize != sizeof(TPointFileHeader) ||
+        !Check_File_Section(size, header.X_Offset, header.Count, sizeof(double)) ||
+        !Check_File_Section(size, header.Y_Offset, header.Count, sizeof(double)) ||
+        (header.Data_Offset != 0 && !Check_File_Section(size, header.Data_Offset, header.Count, sizeof(uint64_t))))
+        return false;
+
+    if (!Append)
+        Clear(); // clear all data
+
+    const double* const    x_arr     = reinterpret_cast<const double*>(data + header.X_Offset);
+    const double* const    y_arr     = reinterpret_cast<const double*>(data + header.Y_Offset);
+    const uint64_t* const  data_arr  = header.Data_Offset != 0 ? reinterpret_cast<const uint64_t*>(data + header.Data_Offset) : nullptr;
+
+    // Load by parts that fit into the size of the arrays of Load_Dots, datasets are copied to the arena, so the file is not needed after loading
+    for (uint64_t first = 0; first < header.Count;)
+    {
+        const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(header.Count - first, 0xFFFFFFFFULL));
+
+        Out_RejectedCount += Load_Dots(MapDot, count, x_arr + first, y_arr + first, data_arr ? data_arr + first : nullptr, &DataArena);
+        first             += count;
+    }
+
+    Index_Dots(MapDot, VecDot); // new dots get the next indices
+    Compact_Dot_Data(false);    // values of changed datasets are reclaimed when the arena doubles
+
+    TagIndex_Actual = false;
+    Views_Changed();
+
+    return true;
+}
+
+namespace NS_Clustering
+{
+    static const std::size_t  Text_Chunk_Size    = 1 << 22;  // size of the chunk of text files read at once
+    static const std::size_t  Point_Batch_Size   = 1 << 20;  // number of points of text files passed to Load_Dots at once
+    static const std::size_t  GeoJSON_Lookahead  = 256;      // maximum length of the text of coordinates of a GeoJSON point
+
+    // Skip spaces and tabs
+    inline const char* Skip_Spaces(const char* First, const char* const Last) noexcept
+    {
+        while (First != Last && (*First == ' ' || *First == '\t' || *First == '\r' || *First == '\n'))
+            ++First;
+
+        return First;
+    }
+
+    /* Parse a number at the beginning of the text (nullptr - there is no number). Numbers with up to 19 significant digits and
+    a decimal exponent up to 22 are converted exactly by one multiplication or division, the rest - by strtod with the decimal
+    point of the current locale. Such numbers are not parsed if their text has 64 characters or more. */
+    const char* Parse_Double(const char* const First, const char* const Last, double& Value) noexcept
+    {
+        static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+            1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        const char*  p          = First;
+        bool         negative   = false;  // sign of the number
+        uint64_t     mantissa   = 0;      // significant digits
+        int32_t      digits     = 0;      // number of significant digits in the mantissa
+        int32_t      exponent   = 0;      // decimal exponent of the mantissa
+        bool         truncated  = false;  // not all significant digits fit in the mantissa
+        bool         found      = false;  // at least one digit is found
+
+        if (p != Last && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+
+        for (; p != Last && *p >= '0' && *p <= '9'; ++p) // integer part
+        {
+            found = true;
+
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += mantissa != 0 ? 1 : 0; // leading zeros are not significant
+            }
+            else
+            {
+                truncated = truncated || *p != '0';
+                ++exponent;
+            }
+        }
+
+        if (p != Last && *p == '.') // fractional part
+        {
+            for (++p; p != Last && *p >= '0' && *p <= '9'; ++p)
+            {
+                found = true;
+
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0 ? 1 : 0;
+                    --exponent;
+                }
+                else
+                    truncated = truncated || *p != '0';
+            }
+        }
+
+        if (!found)
+            return nullptr;
+
+        if (p != Last && (*p == 'e' || *p == 'E')) // exponent
+        {
+            const char*  e       = p + 1;
+            bool         e_neg   = false;
+            int32_t      e_val   = 0;
+
+            if (e != Last && (*e == '-' || *e == '+'))
+                e_neg = *e++ == '-';
+
+            if (e == Last || *e < '0' || *e > '9')
+                return nullptr;
+
+            for (; e != Last && *e >= '0' && *e <= '9'; ++e)
+                e_val = std::min(e_val * 10 + (*e - '0'), 100000);
+
+            exponent += e_neg ? -e_val : e_val;
+            p         = e;
+        }
+
+        if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) // exact conversion
+            Value = exponent < 0 ? static_cast<double>(mantissa) / pow10[-exponent] : static_cast<double>(mantissa) * pow10[exponent];
+        else // long number, the text is copied, since strtod needs a terminating zero
+        {
+            char   text[64];
+            char*  text_end = nullptr;  // end of the number converted by strtod
+
+            if (p - First >= static_cast<std::ptrdiff_t>(sizeof(text)))
+                return nullptr;
+
+            std::copy(First, p, text);
+            text[p - First] = '\0';
+            std::replace(text, text + (p - First), '.', *std::localeconv()->decimal_point); // strtod expects the decimal point of the locale
+
+            Value = std::abs(std::strtod(text, &text_end));
+
+            if (text_end != text + (p - First)) // strtod did not convert the whole number
+                return nullptr;
+        }
+
+        if (negative)
+            Value = -Value;
+
+        return p;
+    }
+
+    // Parse an unsigned integer at the beginning of the text (nullptr - there is no number)
+    const char* Parse_UInt64(const char* First, const char* const Last, uint64_t& Value) noexcept
+    {
+        if (First == Last || *First < '0' || *First > '9')
+            return nullptr;
+
+        for (Value = 0; First != Last && *First >= '0' && *First <= '9'; ++First)
+            Value = Value * 10 + static_cast<uint64_t>(*First - '0');
+
+        return First;
+    }
+
+    // Points parsed from a text file, they are passed to Load_Dots by batches, so the memory does not depend on the size of the file
+    class TPointBatch
+    {
+    private:
+        TClusterizator&        Clusterizator;
+        const bool             HasData;  // points have data
+        std::vector<double>    X_Arr;
+        std::vector<double>    Y_Arr;
+        std::vector<uint64_t>  Data_Arr;
+
+    public:
+        uint64_t  PointCount;     // number of loaded points
+        uint64_t  RejectedCount;  // number of points with incorrect or non-finite coordinates
+
+
+        TPointBatch(TClusterizator& Clusterizator_, const bool HasData_) :
+            Clusterizator(Clusterizator_),
+            HasData      (HasData_),
+            PointCount   (0),
+            RejectedCount(0)
+        {
+            X_Arr.reserve(Point_Batch_Size);
+            Y_Arr.reserve(Point_Batch_Size);
+
+            if (HasData)
+                Data_Arr.reserve(Point_Batch_Size);
+        }
+
+        // Add point, the batch is loaded when it is full
+        void Add(const double X, const double Y, const uint64_t Data)
+        {
+            X_Arr.push_back(X);
+            Y_Arr.push_back(Y);
+
+            if (HasData)
+                Data_Arr.push_back(Data);
+
+            if (X_Arr.size() == Point_Batch_Size)
+                Flush();
+        }
+
+        // Load collected points
+        void Flush(void)
+        {
+            if (!X_Arr.empty())
+            {
+                const uint32_t rejected = Load_Dots(Clusterizator.MapDot, static_cast<uint32_t>(X_Arr.size()), X_Arr.data(), Y_Arr.data(), HasData ? Data_Arr.data() : nullptr, &Clusterizator.DataArena);
+
+                PointCount     += X_Arr.size() - rejected;
+                RejectedCount  += rejected;
+
+                X_Arr.clear();
+                Y_Arr.clear();
+                Data_Arr.clear();
+            }
+        }
+    };
+
+    /* Read the text file by chunks. Opened() is called when the file is opened, before it is read. Parse(First, Last, IsEnd)
+    processes the text of the chunk and returns the position of its unprocessed rest, which is moved to the beginning of the
+    next chunk (the chunk grows if nothing is processed). */
+    template <typename Opener, typename Parser> bool Read_Text_File(const char* const FileName, Opener&& Opened, Parser&& Parse)
+    {
+        std::vector<char>  chunk(Text_Chunk_Size);  // text of the chunk
+        std::size_t        rest = 0;                // size of the unprocessed rest of the previous chunk at the beginning
+        bool               end  = false;            // end of the file is reached
+
+        std::FILE* const file = std::fopen(FileName, "rb");
+
+        if (!file)
+            return false;
+
+        try
+        {
+            Opened();
+
+            while (!end)
+            {
+                if (rest == chunk.size()) // the rest takes the whole chunk
+                    chunk.resize(chunk.size() * 2);
+
+                const std::size_t read = std::fread(chunk.data() + rest, 1, chunk.size() - rest, file);
+
+                end = read < chunk.size() - rest;
+
+                const char* const  first      = chunk.data();
+                const char* const  last       = first + rest + read;
+                const char* const  processed  = Parse(first, last, end);
+
+                rest = static_cast<std::size_t>(last - processed);
+
+                std::copy(processed, last, chunk.data()); // move the rest to the beginning (it does not overlap the destination from the left)
+            }
+        }
+        catch (...)
+        {
+            std::fclose(file);
+
+            throw;
+        }
+
+        const bool result = !std::ferror(file);
+
+        std::fclose(file);
+
+        return result;
+    }
+}
+
+// Load dots from the CSV file
+bool NS_Clustering::TClusterizator::Load_CSV_File(const char* const FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const bool Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount)
+{
+    if (X_Column < 0 || Y_Column < 0)
+        return false;
+
+    TPointBatch  batch(*this, Data_Column >= 0);
+    uint64_t     line_number = 0;  // number of the current line
+
+    const bool result = Read_Text_File(FileName, [this, Append]() { if (!Append) Clear(); }, // data is cleared only if the file is opened
+        [&](const char* First, const char* const Last, const bool IsEnd)
+    {
+        while (First != Last)
+        {
+            const char* line_end = static_cast<const char*>(std::memchr(First, '\n', Last - First));
+
+            if (!line_end) // incomplete line
+            {
+                if (!IsEnd)
+                    break;
+
+                line_end = Last;
+            }
+
+            const char* const next = line_end == Last ? Last : line_end + 1;
+
+            if (line_end != First && line_end[-1] == '\r')
+                --line_end;
+
+            if (line_number++ >= SkipLines && line_end != First) // not a header and not an empty line
+            {
+                double       x = 0.0, y = 0.0;
+                uint64_t     data = 0;
+                int32_t      found = 0;   // number of parsed columns
+                int32_t      column = 0;  // number of the current column
+                const char*  field = First;
+
+                // Find delimiters by memchr, only the necessary columns are parsed
+                for (; field != nullptr; ++column)
+                {
+                    const char* field_end = static_cast<const char*>(std::memchr(field, Delimiter, line_end - field));
+
+                    if (!field_end)
+                        field_end = line_end;
+
+                    if (column == X_Column || column == Y_Column || column == Data_Column)
+                    {
+                        const char* const  value  = Skip_Spaces(field, field_end);
+                        const char*        parsed = nullptr;
+
+                        if (column == X_Column)
+                            parsed = Parse_Double(value, field_end, x);
+                        else if (column == Y_Column)
+                            parsed = Parse_Double(value, field_end, y);
+                        else
+                            parsed = Parse_UInt64(value, field_end, data);
+
+                        if (!parsed || Skip_Spaces(parsed, field_end) != field_end) // not a number
+                            break;
+
+                        ++found;
+                    }
+
+                    field = field_end != line_end ? field_end + 1 : nullptr;
+                }
+
+                if (found == (Data_Column >= 0 ? 3 : 2))
+                    batch.Add(x, y, data);
+                else
+                    ++batch.RejectedCount;
+            }
+
+            First = next;
+        }
+
+        return First;
+    });
+
+    batch.Flush();
+
+    Index_Dots(MapDot, VecDot); // new dots get the next indices
+    Compact_Dot_Data(false);    // values of changed datasets are reclaimed when the arena doubles
+
+    TagIndex_Actual = false;
+    Views_Changed();
+
+    Out_PointCount     = batch.PointCount;
+    Out_RejectedCount  = batch.RejectedCount;
+
+    return result;
+}
+
+// Load dots from the GeoJSON file
+bool NS_Clustering::TClusterizator::Load_GeoJSON_File(const char* const FileName, const bool Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount)
+{
+    static const char         key[]     = "\"coordinates\"";
+    static const std::size_t  key_size  = sizeof(key) - 1;
+
+    TPointBatch  batch(*this, true);
+    uint64_t     member_number = 0; // number of the current "coordinates" member of any geometry, is the data of the point
+
+    const bool result = Read_Text_File(FileName, [this, Append]() { if (!Append) Clear(); }, // data is cleared only if the file is opened
+        [&](const char* First, const char* const Last, const bool IsEnd)
+    {
+        // Coordinates closer to the end of the chunk than the maximum length of their text are parsed in the next chunk
+        const char* const limit = IsEnd ? Last : (static_cast<std::size_t>(Last - First) > GeoJSON_Lookahead ? Last - GeoJSON_Lookahead : First);
+
+        while (First < limit)
+        {
+            // Find quotes by memchr, then compare the key
+            const char* const quote = static_cast<const char*>(std::memchr(First, '"', limit - First));
+
+            if (!quote)
+                return limit;
+
+            if (static_cast<std::size_t>(Last - quote) < key_size || !std::equal(key, key + key_size, quote))
+            {
+                First = quote + 1;
+
+                continue;
+            }
+
+            double       x = 0.0, y = 0.0;
+            const char*  p = Skip_Spaces(quote + key_size, Last);
+
+            First = quote + key_size;
+
+            if (p == Last || *p != ':')
+                continue; // not a member name
+
+            p = Skip_Spaces(p + 1, Last);
+
+            if (p == Last || *p != '[')
+                continue;
+
+            p = Skip_Spaces(p + 1, Last);
+
+            const uint64_t number = member_number++;
+
+            if (p != Last && *p == '[')
+                continue; // not a point
+
+            // [x, y] or [x, y, z]
+            if ((p = Parse_Double(p, Last, x)) != nullptr && (p = Skip_Spaces(p, Last)) != Last && *p == ',' &&
+                (p = Parse_Double(Skip_Spaces(p + 1, Last), Last, y)) != nullptr && (p = Skip_Spaces(p, Last)) != Last && (*p == ']' || *p == ','))
+            {
+                batch.Add(x, y, number);
+                First = p;
+            }
+            else
+                ++batch.RejectedCount;
+        }
+
+        return First;
+    });
+
+    batch.Flush();
+
+    Index_Dots(MapDot, VecDot); // new dots get the next indices
+    Compact_Dot_Data(false);    // values of changed datasets are reclaimed when the arena doubles
+
+    TagIndex_Actual = false;
+    Views_Changed();
+
+    Out_PointCount     = batch.PointCount;
+    Out_RejectedCount  = batch.RejectedCount;
+
+    return result;
+}
+/****************************************************************************************************/
+
+/*** TClusterizatorRegistry *************************************************************************/
+NS_Clustering::TClusterizatorRegistry::TClusterizatorRegistry(void) noexcept :
+    Last_Id(0)
+{}
+
+// Create a new clusterizator
+uint32_t NS_Clustering::TClusterizatorRegistry::New(void) noexcept
+{
+    uint32_t id = Last_Id.load();
+
+    // Take the next id, ids are not reused
+    do
+    {
+        if (id == 0xFFFFFFFF)
+            return 0;
+    }
+    while (!Last_Id.compare_exchange_weak(id, id + 1));
+
+    ++id;
+
+    try
+    {
+        std::shared_ptr<TClusterizator>  clusterizator  = std::make_shared<TClusterizator>(id);
+        TShard&                          shard          = Shards[id % Shard_Count];
+        std::lock_guard<std::mutex>      lock(shard.Mutex);
+
+        shard.MapClusterizator.emplace(id, std::move(clusterizator));
+    }
+    catch (...)
+    {
+        return 0;
+    }
+
+    return id;
+}
+
+// Delete clusterizator
+bool NS_Clustering::TClusterizatorRegistry::Delete(const uint32_t Id) noexcept
+{
+    std::shared_ptr<TClusterizator> clusterizator; // it is released after unlocking of the shard
+
+    {
+        TShard&                      shard = Shards[Id % Shard_Count];
+        std::lock_guard<std::mutex>  lock(shard.Mutex);
+
+        const auto it = shard.MapClusterizator.find(Id);
+
+        if (it == shard.MapClusterizator.end())
+            return false;
+
+        clusterizator = std::move(it->second);
+        shard.MapClusterizator.erase(it);
+    }
+
+    std::lock_guard<std::mutex> lock(clusterizator->Mutex); // wait for the end of the call by the handle, it is unlocked before releasing
+
+    return true;
+}
+
+// Delete all clusterizators
+void NS_Clustering::TClusterizatorRegistry::Delete_All(void) noexcept
+{
+    for (TShard& shard : Shards)
+    {
+        TMap map_clusterizator; // clusterizators are released after unlocking of the shard
+
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+
+            map_clusterizator.swap(shard.MapClusterizator);
+        }
+
+        for (const auto& clusterizator : map_clusterizator)
+        {
+            std::lock_guard<std::mutex> lock(clusterizator.second->Mutex); // wait for the end of the call by the handle
+        }
+    }
+}
+
+// Find clusterizator
+std::shared_ptr<NS_Clustering::TClusterizator> NS_Clustering::TClusterizatorRegistry::Find(const uint32_t Id) const noexcept
+{
+    const TShard&                shard = Shards[Id % Shard_Count];
+    std::lock_guard<std::mutex>  lock(shard.Mutex);
+
+    const auto cit = shard.MapClusterizator.find(Id);
+
+    return cit != shard.MapClusterizator.cend() ? cit->second : nullptr;
+}
+
+// Lock the clusterizator if it is in the registry
+bool NS_Clustering::TClusterizatorRegistry::Lock_If_Contains(TClusterizator* const Clusterizator, std::unique_lock<std::mutex>& Lock) const noexcept
+{
+    for (const TShard& shard : Shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        for (const auto& clusterizator : shard.MapClusterizator)
+        {
+            if (clusterizator.second.get() == Clusterizator)
+            {
+                Lock = std::unique_lock<std::mutex>(Clusterizator->Mutex); // Delete removes it from the shard before waiting for this lock
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+/****************************************************************************************************/
+
+
+/*** TLockedClusterizator ***************************************************************************/
+NS_Clustering::TLockedClusterizator::TLockedClusterizator(const HClusterizator Handle) noexcept :
+    Clusterizator(Handle)
+{
+    #if defined(SIMPLE_CLUSTERING_CHECK_HANDLES)
+      if (Clusterizator && !Registry.Lock_If_Contains(Clusterizator, Lock)) // the clusterizator is deleted or it is not a handle
+          Clusterizator = nullptr;
+    #else
+      if (Clusterizator)
+          Lock = std::unique_lock<std::mutex>(Clusterizator->Mutex);
+    #endif
+}
+
+// Whether the clusterizator is found
+NS_Clustering::TLockedClusterizator::operator bool(void) const noexcept
+{
+    return Clusterizator != nullptr;
+}
+
+NS_Clustering::TClusterizator* NS_Clustering::TLockedClusterizator::operator -> (void) const noexcept
+{
+    return Clusterizator;
+}
+
+NS_Clustering::TClusterizator& NS_Clustering::TLockedClusterizator::operator * (void) const noexcept
+{
+    return *Clusterizator;
+}
+/****************************************************************************************************/
+
+
+// Reset radius of all clustering elements to default values
+void NS_Clustering::ClusteringElems_Set_Default_Radius(void) noexcept
+{
+    Dot_Radius        = 10.0;
+    Cluster_1_Radius  = 50.0;
+    Cluster_2_Radius  = 300.0;
+    Cluster_3_Radius  = 1500.0;
+    Cluster_4_Radius  = 10000.0;
+
+    const_cast<double&>(Dot_Radius_)        = Dot_Radius;
+    const_cast<double&>(Cluster_1_Radius_)  = Cluster_1_Radius;
+    const_cast<double&>(Cluster_2_Radius_)  = Cluster_2_Radius;
+    const_cast<double&>(Cluster_3_Radius_)  = Cluster_3_Radius;
+    const_cast<double&>(Cluster_4_Radius_)  = Cluster_4_Radius;
+}
+
+// Set the radius of all clustering elements
+int32_t NS_Clustering::ClusteringElems_Set_Radius(const double Dot_R, const double Cluster_1_R, const double Cluster_2_R, const double Cluster_3_R, const double Cluster_4_R) noexcept
+{
+    if (!Coord_Is_Valid(Dot_R) || !Coord_Is_Valid(Cluster_1_R) || !Coord_Is_Valid(Cluster_2_R) || !Coord_Is_Valid(Cluster_3_R) || !Coord_Is_Valid(Cluster_4_R))
+        return 1;
+
+    // The order is checked after rounding, so that radii that become equal in integer coordinates are rejected
+    const TCoord  dot_r  = To_Coord(Dot_R);
+    const TCoord  c1_r   = To_Coord(Cluster_1_R);
+    const TCoord  c2_r   = To_Coord(Cluster_2_R);
+    const TCoord  c3_r   = To_Coord(Cluster_3_R);
+    const TCoord  c4_r   = To_Coord(Cluster_4_R);
+
+    if (dot_r > 0 &&
+        c1_r > dot_r &&
+        c2_r > c1_r &&
+        c3_r > c2_r &&
+        c4_r > c3_r)
+    {
+        Dot_Radius        = dot_r;
+        Cluster_1_Radius  = c1_r;
+        Cluster_2_Radius  = c2_r;
+        Cluster_3_Radius  = c3_r;
+        Cluster_4_Radius  = c4_r;
+
+        const_cast<double&>(Dot_Radius_)        = Dot_Radius;
+        const_cast<double&>(Cluster_1_Radius_)  = Cluster_1_Radius;
+        const_cast<double&>(Cluster_2_Radius_)  = Cluster_2_Radius;
+        const_cast<double&>(Cluster_3_Radius_)  = Cluster_3_Radius;
+        const_cast<double&>(Cluster_4_Radius_)  = Cluster_4_Radius;
+
+        return 0;
+    }
+    else
+        return 1;
+}
+
+// Reset settings of the additional radius value to default
+void NS_Clustering::ClusteringElems_Set_Default_AdditionalRadiusValue_Settings(void) noexcept
+{
+    AdditionalRadiusValue      = 3.0;
+    Use_AdditionalRadiusValue  = 1;
+
+    const_cast<double&>(AdditionalRadiusValue_)       = AdditionalRadiusValue;
+    const_cast<int16_t&>(Use_AdditionalRadiusValue_)  = Use_AdditionalRadiusValue;
+}
+
+// Set settings of the additional radius value
+void NS_Clustering::ClusteringElems_Set_AdditionalRadiusValue_Settings(const double Value, const int16_t Usage) noexcept
+{
+    if (Value < Dot_Radius_ && (Usage == 0 || Usage == 1))
+    {
+        AdditionalRadiusValue      = To_Coord(Value);
+        Use_AdditionalRadiusValue  = Usage;
+
+        const_cast<double&>(AdditionalRadiusValue_)       = AdditionalRadiusValue;
+        const_cast<int16_t&>(Use_AdditionalRadiusValue_)  = Use_AdditionalRadiusValue;
+    }
+}
+
+
+// Project geographic coordinates to Web Mercator
+int32_t NS_Clustering::Coords_Geo_To_Web_Mercator(const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, double* Out_X_Arr, double* Out_Y_Arr) noexcept
+{
+    if (Lon_Arr && Lat_Arr && Out_X_Arr && Out_Y_Arr)
+    {
+        try
+        {
+            Project_Web_Mercator(ArrSize, Lon_Arr, Lat_Arr, Out_X_Arr, Out_Y_Arr);
+
+            return 0;
+        }
+        catch (...) {}
+    }
+
+    return 1;
+}
+
+// Convert Web Mercator coordinates to geographic ones
+int32_t NS_Clustering::Coords_Web_Mercator_To_Geo(const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, double* Out_Lon_Arr, double* Out_Lat_Arr) noexcept
+{
+    if (X_Arr && Y_Arr && Out_Lon_Arr && Out_Lat_Arr)
+    {
+        try
+        {
+            Unproject_Web_Mercator(ArrSize, X_Arr, Y_Arr, Out_Lon_Arr, Out_Lat_Arr);
+
+            return 0;
+        }
+        catch (...) {}
+    }
+
+    return 1;
+}
+
+
+/* Functions for the id call the functions for the handle of the clusterizator found in the registry, the found shared_ptr holds
+the clusterizator until the end of the call. Functions for the handle lock the clusterizator by TLockedClusterizator for the
+call and record it as the event of the trace of the clusterizator (TTraceScope). */
+
+// Create a new clusterizator. Its code is returned
+uint32_t NS_Clustering::Clusterizator_New(void) noexcept
+{
+    return Registry.New();
+}
+
+// Delete clusterizator
+int32_t NS_Clustering::Clusterizator_Delete(const uint32_t ClusterizatorId) noexcept
+{
+    return ClusterizatorId > 0 && Registry.Delete(ClusterizatorId) ? 0 : 1;
+}
+
+// Delete all clusterizators
+void NS_Clustering::Clusterizator_Delete_All(void) noexcept
+{
+    Registry.Delete_All();
+}
+
+// Create a new clusterizator. Its handle is returned
+NS_Clustering::HClusterizator NS_Clustering::HClusterizator_New(void) noexcept
+{
+    return HClusterizator_Find(Registry.New());
+}
+
+// Get the handle of the clusterizator by its id
+NS_Clustering::HClusterizator NS_Clustering::HClusterizator_Find(const uint32_t ClusterizatorId) noexcept
+{
+    return Registry.Find(ClusterizatorId).get(); // the clusterizator stays in the registry
+}
+
+// Get the id of the clusterizator by its handle
+uint32_t NS_Clustering::HClusterizator_Get_Id(HClusterizator Handle) noexcept
+{
+    TLockedClusterizator clusterizator(Handle);
+
+    return clusterizator ? clusterizator->Id : 0;
+}
+
+// Delete clusterizator by its handle
+int32_t NS_Clustering::HClusterizator_Delete(HClusterizator Handle) noexcept
+{
+    const uint32_t id = HClusterizator_Get_Id(Handle);
+
+    return id > 0 && Registry.Delete(id) ? 0 : 1;
+}
+
+
+// Initialize a set of dots
+int32_t NS_Clustering::HClusterizator_Init_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    if (Handle && ArrSize > 0 && X_Arr && Y_Arr)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Init_Dots");
+
+            clusterizator->Clear(); // clear all data
+
+            Load_Dots(clusterizator->MapDot, ArrSize, X_Arr, Y_Arr, Address_Of_Data_Arr ? *Address_Of_Data_Arr : nullptr, &clusterizator->DataArena);
+            Index_Dots(clusterizator->MapDot, clusterizator->VecDot);
+            clusterizator->Compact_Dot_Data(false); // values of changed datasets are reclaimed when the arena doubles
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Initialize a set of dots
+int32_t NS_Clustering::Clusterizator_Init_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    return HClusterizator_Init_Dots(Registry.Find(ClusterizatorId).get(), ArrSize, X_Arr, Y_Arr, Address_Of_Data_Arr);
+}
+
+// Add a set of dots to the existing dots
+int32_t NS_Clustering::HClusterizator_Append_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    if (Handle && ArrSize > 0 && X_Arr && Y_Arr)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Append_Dots");
+
+            Load_Dots(clusterizator->MapDot, ArrSize, X_Arr, Y_Arr, Address_Of_Data_Arr ? *Address_Of_Data_Arr : nullptr, &clusterizator->DataArena);
+            Index_Dots(clusterizator->MapDot, clusterizator->VecDot); // new dots get the next indices
+            clusterizator->Compact_Dot_Data(false); // values of changed datasets are reclaimed when the arena doubles
+
+            clusterizator->TagIndex_Actual = false; // new dots may have tags
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Add a set of dots to the existing dots
+int32_t NS_Clustering::Clusterizator_Append_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    return HClusterizator_Append_Dots(Registry.Find(ClusterizatorId).get(), ArrSize, X_Arr, Y_Arr, Address_Of_Data_Arr);
+}
+
+// Initialize a set of dots with geographic coordinates
+int32_t NS_Clustering::HClusterizator_Init_Geo_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    if (Handle && ArrSize > 0 && Lon_Arr && Lat_Arr)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Init_Geo_Dots");
+
+            std::vector<double>  x_arr(ArrSize);
+            std::vector<double>  y_arr(ArrSize);
+
+            Project_Web_Mercator(ArrSize, Lon_Arr, Lat_Arr, x_arr.data(), y_arr.data()); // dots keep the projected coordinates
+
+            clusterizator->Clear(); // clear all data
+
+            Load_Dots(clusterizator->MapDot, ArrSize, x_arr.data(), y_arr.data(), Address_Of_Data_Arr ? *Address_Of_Data_Arr : nullptr, &clusterizator->DataArena);
+            Index_Dots(clusterizator->MapDot, clusterizator->VecDot);
+            clusterizator->Compact_Dot_Data(false); // values of changed datasets are reclaimed when the arena doubles
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Initialize a set of dots with geographic coordinates
+int32_t NS_Clustering::Clusterizator_Init_Geo_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    return HClusterizator_Init_Geo_Dots(Registry.Find(ClusterizatorId).get(), ArrSize, Lon_Arr, Lat_Arr, Address_Of_Data_Arr);
+}
+
+// Add a set of dots with geographic coordinates to the existing dots
+int32_t NS_Clustering::HClusterizator_Append_Geo_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    if (Handle && ArrSize > 0 && Lon_Arr && Lat_Arr)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Append_Geo_Dots");
+
+            std::vector<double>  x_arr(ArrSize);
+            std::vector<double>  y_arr(ArrSize);
+
+            Project_Web_Mercator(ArrSize, Lon_Arr, Lat_Arr, x_arr.data(), y_arr.data()); // dots keep the projected coordinates
+
+            Load_Dots(clusterizator->MapDot, ArrSize, x_arr.data(), y_arr.data(), Address_Of_Data_Arr ? *Address_Of_Data_Arr : nullptr, &clusterizator->DataArena);
+            Index_Dots(clusterizator->MapDot, clusterizator->VecDot); // new dots get the next indices
+            clusterizator->Compact_Dot_Data(false); // values of changed datasets are reclaimed when the arena doubles
+
+            clusterizator->TagIndex_Actual = false; // new dots may have tags
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Add a set of dots with geographic coordinates to the existing dots
+int32_t NS_Clustering::Clusterizator_Append_Geo_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr)
+{
+    return HClusterizator_Append_Geo_Dots(Registry.Find(ClusterizatorId).get(), ArrSize, Lon_Arr, Lat_Arr, Address_Of_Data_Arr);
+}
+
+// Add a set of timed dots of the sliding window
+int32_t NS_Clustering::HClusterizator_Append_Timed_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr) noexcept
+{
+    if (Handle && ArrSize > 0 && X_Arr && Y_Arr && Time_Arr)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Append_Timed_Dots");
+
+            try
+            {
+                clusterizator->Append_Timed_Dots(ArrSize, X_Arr, Y_Arr, Time_Arr, Address_Of_Data_Arr ? *Address_Of_Data_Arr : nullptr);
+
+                return 0;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Add a set of timed dots of the sliding window
+int32_t NS_Clustering::Clusterizator_Append_Timed_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr) noexcept
+{
+    return HClusterizator_Append_Timed_Dots(Registry.Find(ClusterizatorId).get(), ArrSize, X_Arr, Y_Arr, Time_Arr, Address_Of_Data_Arr);
+}
+
+// Delete timed dots that left the sliding window
+int32_t NS_Clustering::HClusterizator_Expire_Dots(HClusterizator Handle, const int64_t Min_Time, uint32_t& Out_ExpiredCount) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Expire_Dots");
+
+            try
+            {
+                Out_ExpiredCount = clusterizator->Expire_Dots(Min_Time);
+
+                return 0;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Delete timed dots that left the sliding window
+int32_t NS_Clustering::Clusterizator_Expire_Dots(const uint32_t ClusterizatorId, const int64_t Min_Time, uint32_t& Out_ExpiredCount) noexcept
+{
+    return HClusterizator_Expire_Dots(Registry.Find(ClusterizatorId).get(), Min_Time, Out_ExpiredCount);
+}
+
+// Load dots from the columnar point file
+int32_t NS_Clustering::HClusterizator_Load_Point_File(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount) noexcept
+{
+    if (Handle && FileName)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Load_Point_File");
+
+            try
+            {
+                if (clusterizator->Load_Point_File(FileName, static_cast<bool>(Append), Out_RejectedCount))
+                    return 0;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Load dots from the columnar point file
+int32_t NS_Clustering::Clusterizator_Load_Point_File(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount) noexcept
+{
+    return HClusterizator_Load_Point_File(Registry.Find(ClusterizatorId).get(), FileName, Append, Out_RejectedCount);
+}
+
+// Load dots from the CSV file
+int32_t NS_Clustering::HClusterizator_Load_CSV_File(HClusterizator Handle, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept
+{
+    if (Handle && FileName)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Load_CSV_File");
+
+            try
+            {
+                if (clusterizator->Load_CSV_File(FileName, Delimiter, SkipLines, X_Column, Y_Column, Data_Column, static_cast<bool>(Append), Out_PointCount, Out_RejectedCount))
+                    return 0;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Load dots from the CSV file
+int32_t NS_Clustering::Clusterizator_Load_CSV_File(const uint32_t ClusterizatorId, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept
+{
+    return HClusterizator_Load_CSV_File(Registry.Find(ClusterizatorId).get(), FileName, Delimiter, SkipLines, X_Column, Y_Column, Data_Column, Append, Out_PointCount, Out_RejectedCount);
+}
+
+// Load point coordinates from the GeoJSON file
+int32_t NS_Clustering::HClusterizator_Load_GeoJSON_File(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept
+{
+    if (Handle && FileName)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Load_GeoJSON_File");
+
+            try
+            {
+                if (clusterizator->Load_GeoJSON_File(FileName, static_cast<bool>(Append), Out_PointCount, Out_RejectedCount))
+                    return 0;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Load point coordinates from the GeoJSON file
+int32_t NS_Clustering::Clusterizator_Load_GeoJSON_File(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept
+{
+    return HClusterizator_Load_GeoJSON_File(Registry.Find(ClusterizatorId).get(), FileName, Append, Out_PointCount, Out_RejectedCount);
+}
+
+// Add single dot
+int32_t NS_Clustering::HClusterizator_Add_Dot(HClusterizator Handle, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress)
+{
+    if (Handle && Coord_Is_Valid(X) && Coord_Is_Valid(Y))
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TMapDot&           map_dot  = clusterizator->MapDot;              // dots
+            TMapDot::iterator  dot      = map_dot.find(TCoordKey(X, Y));  // find dot with the specified coordinates
+
+            if (dot == map_dot.end()) // not found
+            {
+                // Create it
+                if (Address_Of_Data) // data for dot
+                    dot = map_dot.emplace(TCoordKey(X, Y), new TDot(X, Y, *Address_Of_Data)).first;
+                else // no data for dot
+                    dot = map_dot.emplace(TCoordKey(X, Y), new TDot(X, Y)).first;
+
+                Index_ClusteringElem(dot->second, clusterizator->VecDot); // dot gets the next index
+            }
+            else // found
+            {
+                // Add data to the dataset in the dot, the amount of data of the clusters that contain the dot is also changed
+                if (Address_Of_Data && dot->second->SetData.insert(*Address_Of_Data))
+                    Change_Counts_Of_Parents(dot->second, 1, 0);
+            }
+
+            Out_DotTagAddress = reinterpret_cast<uint64_t*>(&dot->second->Tag); // address of dots tag
+
+            clusterizator->TagIndex_Actual = false; // the dot can be new
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Add single dot
+int32_t NS_Clustering::Clusterizator_Add_Dot(const uint32_t ClusterizatorId, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress)
+{
+    return HClusterizator_Add_Dot(Registry.Find(ClusterizatorId).get(), X, Y, Address_Of_Data, Out_DotTagAddress);
+}
+
+// Select dots that take part in clustering by the bit mask of their indices
+int32_t NS_Clustering::HClusterizator_Select_Dots(HClusterizator Handle, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount) noexcept
+{
+    if (Handle && (Mask_Arr || DotCount == 0))
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Select_Dots");
+
+            const size_t count = std::min(static_cast<size_t>(DotCount), clusterizator->VecDot.size());
+
+            Out_SelectedCount = 0;
+
+            for (size_t i = 0; i < clusterizator->VecDot.size(); ++i) // dots are flagged in place, dots out of the mask are not selected
+            {
+                TDot* const dot = clusterizator->VecDot[i];
+
+                dot->Selected = i < count && (Mask_Arr[i >> 3] >> (i & 7)) & 1;
+
+                if (dot->Selected)
+                    ++Out_SelectedCount;
+            }
+
+            clusterizator->Views_Changed(); // the view reports the selection
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Select dots that take part in clustering by the bit mask of their indices
+int32_t NS_Clustering::Clusterizator_Select_Dots(const uint32_t ClusterizatorId, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount) noexcept
+{
+    return HClusterizator_Select_Dots(Registry.Find(ClusterizatorId).get(), Mask_Arr, DotCount, Out_SelectedCount);
+}
+
+// Select dots that take part in clustering by their tags
+int32_t NS_Clustering::HClusterizator_Select_Dots_By_Tag(HClusterizator Handle, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Select_Dots_By_Tag");
+
+            Out_SelectedCount = 0;
+
+            for (TDot* const dot : clusterizator->VecDot) // dots are flagged in place, the predicate is checked once per dot
+            {
+                dot->Selected = (dot->Tag & Tag_Mask) == Tag_Value;
+
+                if (dot->Selected)
+                    ++Out_SelectedCount;
+            }
+
+            clusterizator->Views_Changed(); // the view reports the selection
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Select dots that take part in clustering by their tags
+int32_t NS_Clustering::Clusterizator_Select_Dots_By_Tag(const uint32_t ClusterizatorId, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount) noexcept
+{
+    return HClusterizator_Select_Dots_By_Tag(Registry.Find(ClusterizatorId).get(), Tag_Mask, Tag_Value, Out_SelectedCount);
+}
+
+// Create set of clusters_1
+int32_t NS_Clustering::HClusterizator_Create_Clusters_1(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Clusters_1");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[0]); // count the creation of clusters_1
+            #endif
+
+            Create_Clusters_1(clusterizator->MapDot, clusterizator->MapCluster_1, static_cast<bool>(SingleDot_To_Cluster_1));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_1, clusterizator->VecCluster_1);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_1
+int32_t NS_Clustering::Clusterizator_Create_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1) noexcept
+{
+    return HClusterizator_Create_Clusters_1(Registry.Find(ClusterizatorId).get(), SingleDot_To_Cluster_1);
+}
+
+// Create set of clusters_2
+int32_t NS_Clustering::HClusterizator_Create_Clusters_2(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Clusters_2");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[1]); // count the creation of clusters_2
+            #endif
+
+            Create_Clusters_2(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, static_cast<bool>(SingleClusteringElem_To_Cluster_2));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_2, clusterizator->VecCluster_2);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_2
+int32_t NS_Clustering::Clusterizator_Create_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2) noexcept
+{
+    return HClusterizator_Create_Clusters_2(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_2);
+}
+
+// Create set of clusters_3
+int32_t NS_Clustering::HClusterizator_Create_Clusters_3(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Clusters_3");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[2]); // count the creation of clusters_3
+            #endif
+
+            Create_Clusters_3(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, clusterizator->MapCluster_3, static_cast<bool>(SingleClusteringElem_To_Cluster_3));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_3, clusterizator->VecCluster_3);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_3
+int32_t NS_Clustering::Clusterizator_Create_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3) noexcept
+{
+    return HClusterizator_Create_Clusters_3(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_3);
+}
+
+// Create set of clusters_4
+int32_t NS_Clustering::HClusterizator_Create_Clusters_4(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Clusters_4");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[3]); // count the creation of clusters_4
+            #endif
+
+            Create_Clusters_4(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, clusterizator->MapCluster_3, clusterizator->MapCluster_4, static_cast<bool>(SingleClusteringElem_To_Cluster_4));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_4, clusterizator->VecCluster_4);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_4
+int32_t NS_Clustering::Clusterizator_Create_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4) noexcept
+{
+    return HClusterizator_Create_Clusters_4(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_4);
+}
+
+// Create set of clusters_1 by the grid
+int32_t NS_Clustering::HClusterizator_Create_Grid_Clusters_1(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Grid_Clusters_1");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[0]); // count the creation of clusters_1
+            #endif
+
+            Create_Grid_Clusters_1(clusterizator->MapDot, clusterizator->MapCluster_1, static_cast<bool>(SingleDot_To_Cluster_1), static_cast<bool>(Merge_Neighbors));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_1, clusterizator->VecCluster_1);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_1 by the grid
+int32_t NS_Clustering::Clusterizator_Create_Grid_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors) noexcept
+{
+    return HClusterizator_Create_Grid_Clusters_1(Registry.Find(ClusterizatorId).get(), SingleDot_To_Cluster_1, Merge_Neighbors);
+}
+
+// Create set of clusters_2 by the grid
+int32_t NS_Clustering::HClusterizator_Create_Grid_Clusters_2(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Grid_Clusters_2");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[1]); // count the creation of clusters_2
+            #endif
+
+            Create_Grid_Clusters_2(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, static_cast<bool>(SingleClusteringElem_To_Cluster_2), static_cast<bool>(Merge_Neighbors));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_2, clusterizator->VecCluster_2);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_2 by the grid
+int32_t NS_Clustering::Clusterizator_Create_Grid_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors) noexcept
+{
+    return HClusterizator_Create_Grid_Clusters_2(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_2, Merge_Neighbors);
+}
+
+// Create set of clusters_3 by the grid
+int32_t NS_Clustering::HClusterizator_Create_Grid_Clusters_3(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Grid_Clusters_3");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[2]); // count the creation of clusters_3
+            #endif
+
+            Create_Grid_Clusters_3(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, clusterizator->MapCluster_3, static_cast<bool>(SingleClusteringElem_To_Cluster_3), static_cast<bool>(Merge_Neighbors));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_3, clusterizator->VecCluster_3);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_3 by the grid
+int32_t NS_Clustering::Clusterizator_Create_Grid_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors) noexcept
+{
+    return HClusterizator_Create_Grid_Clusters_3(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_3, Merge_Neighbors);
+}
+
+// Create set of clusters_4 by the grid
+int32_t NS_Clustering::HClusterizator_Create_Grid_Clusters_4(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Grid_Clusters_4");
+
+            #if defined(SIMPLE_CLUSTERING_STATS)
+              TStatsScope stats_scope(clusterizator->Stats[3]); // count the creation of clusters_4
+            #endif
+
+            Create_Grid_Clusters_4(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, clusterizator->MapCluster_3, clusterizator->MapCluster_4, static_cast<bool>(SingleClusteringElem_To_Cluster_4), static_cast<bool>(Merge_Neighbors));
+            Index_Map_Of_ClusteringElem(clusterizator->MapCluster_4, clusterizator->VecCluster_4);
+            clusterizator->TagIndex_Actual = false; // clusters are recreated
+            clusterizator->Views_Changed();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Create set of clusters_4 by the grid
+int32_t NS_Clustering::Clusterizator_Create_Grid_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors) noexcept
+{
+    return HClusterizator_Create_Grid_Clusters_4(Registry.Find(ClusterizatorId).get(), SingleClusteringElem_To_Cluster_4, Merge_Neighbors);
+}
+
+// Create all sets of clusters progressively
+int32_t NS_Clustering::HClusterizator_Create_Clusters_Progressive(HClusterizator Handle, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context) noexcept
+{
+    const uint32_t id = HClusterizator_Get_Id(Handle); // 0 - the clusterizator is not found
+
+    // The callback may delete the clusterizator, so it is kept alive until the end, and the refinement stops if it is deleted
+    const std::shared_ptr<TClusterizator>  owner    = Registry.Find(id);
+    const auto                             deleted  = [id, &owner]() { return Registry.Find(id) != owner; };
+
+    if (id == 0 || !owner || HClusterizator_Clear_Clusters(Handle) != 0)
+        return 1;
+
+    // Coarse preview of clusters_4 directly from dots, each step locks the clusterizator itself, so the callback can read it
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (!clusterizator)
+            return 1;
+
+        TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Create_Clusters_Progressive");
+
+        Create_Grid_Clusters_4(clusterizator->MapDot, clusterizator->MapCluster_1, clusterizator->MapCluster_2, clusterizator->MapCluster_3, clusterizator->MapCluster_4, (SingleElem_Mask & 8) != 0, true);
+        Index_Map_Of_ClusteringElem(clusterizator->MapCluster_4, clusterizator->VecCluster_4);
+        clusterizator->TagIndex_Actual = false; // clusters are recreated
+        clusterizator->Views_Changed();
+    }
+
+    if (Callback && Callback(Context, id, ID_CLUSTER_4, 0) != 0)
+        return deleted() ? 1 : 0;
+
+    // The preview is deleted, so that dots are not in two sets of clusters during the exact creation
+    if (deleted() || HClusterizator_Clear_Clusters(Handle) != 0)
+        return 1;
+
+    using TCreate_Clusters = int32_t (*)(HClusterizator, const int16_t);
+
+    static const TCreate_Clusters create_clusters[4] = {HClusterizator_Create_Clusters_1, HClusterizator_Create_Clusters_2, HClusterizator_Create_Clusters_3, HClusterizator_Create_Clusters_4};
+
+    // Exact sets from the finest to the coarsest
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        if (deleted() || create_clusters[i](Handle, static_cast<int16_t>((SingleElem_Mask >> i) & 1)) != 0)
+            return 1;
+
+        if (Callback && Callback(Context, id, static_cast<uint16_t>(ID_CLUSTER_1 + i), 1) != 0)
+            break;
+    }
+
+    return deleted() ? 1 : 0;
+}
+
+// Create all sets of clusters progressively
+int32_t NS_Clustering::Clusterizator_Create_Clusters_Progressive(const uint32_t ClusterizatorId, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context) noexcept
+{
+    return HClusterizator_Create_Clusters_Progressive(Registry.Find(ClusterizatorId).get(), SingleElem_Mask, Callback, Context);
+}
+
+
+// Clear all sets of clusters
+int32_t NS_Clustering::HClusterizator_Clear_Clusters(HClusterizator Handle) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            clusterizator->Clear_Clusters();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Clear all sets of clusters
+int32_t NS_Clustering::Clusterizator_Clear_Clusters(const uint32_t ClusterizatorId) noexcept
+{
+    return HClusterizator_Clear_Clusters(Registry.Find(ClusterizatorId).get());
+}
+
+// Clear clusterizator
+int32_t NS_Clustering::HClusterizator_Clear(HClusterizator Handle) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            clusterizator->Clear();
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Clear clusterizator
+int32_t NS_Clustering::Clusterizator_Clear(const uint32_t ClusterizatorId) noexcept
+{
+    return HClusterizator_Clear(Registry.Find(ClusterizatorId).get());
+}
+
+
+// Save clusterizator to the snapshot file
+int32_t NS_Clustering::HClusterizator_Save_Snapshot(HClusterizator Handle, const char* FileName) noexcept
+{
+    if (Handle && FileName)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            try
+            {
+                return clusterizator->Save_Snapshot(FileName) ? 0 : 1;
+            }
+            catch (...) {}
+        }
+    }
+
+    return 1;
+}
+
+// Save clusterizator to the snapshot file
+int32_t NS_Clustering::Clusterizator_Save_Snapshot(const uint32_t ClusterizatorId, const char* FileName) noexcept
+{
+    return HClusterizator_Save_Snapshot(Registry.Find(ClusterizatorId).get(), FileName);
+}
+
+// Load clusterizator from the snapshot file
+int32_t NS_Clustering::HClusterizator_Load_Snapshot(HClusterizator Handle, const char* FileName) noexcept
+{
+    if (Handle && FileName)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            try
+            {
+                if (clusterizator->Load_Snapshot(FileName))
+                    return 0;
+            }
+            catch (...) {} // the current data remains
+        }
+    }
+
+    return 1;
+}
+
+// Load clusterizator from the snapshot file
+int32_t NS_Clustering::Clusterizator_Load_Snapshot(const uint32_t ClusterizatorId, const char* FileName) noexcept
+{
+    return HClusterizator_Load_Snapshot(Registry.Find(ClusterizatorId).get(), FileName);
+}
+
+
+// Get the number of clustering elements of the specified id
+uint64_t NS_Clustering::HClusterizator_Get_ClusteringElem_Count(HClusterizator Handle, const uint16_t ClusteringElemId) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            switch (ClusteringElemId)
+            {
+                case ID_DOT:       return clusterizator->MapDot.size();
+                case ID_CLUSTER_1: return clusterizator->MapCluster_1.size();
+                case ID_CLUSTER_2: return clusterizator->MapCluster_2.size();
+                case ID_CLUSTER_3: return clusterizator->MapCluster_3.size();
+                case ID_CLUSTER_4: return clusterizator->MapCluster_4.size();
+
+                default: break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Get the number of clustering elements of the specified id
+uint64_t NS_Clustering::Clusterizator_Get_ClusteringElem_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Count(Registry.Find(ClusterizatorId).get(), ClusteringElemId);
+}
+
+// Get the amount of data for clustering element of the specified id
+uint64_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data_Count(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            switch (ClusteringElemId)
+            {
+                case ID_DOT:       return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->MapDot, X, Y));
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->MapCluster_1, X, Y));
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->MapCluster_2, X, Y));
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->MapCluster_3, X, Y));
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->MapCluster_4, X, Y));
+
+                default: break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Get the amount of data for clustering element of the specified id
+uint64_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Data_Count(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X, Y);
+}
+
+// Get the amount of data for clustering element of the specified id by its index
+uint64_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data_Count_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+        {
+            switch (ClusteringElemId)
+            {
+                case ID_DOT      : return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->VecDot, Index));
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->VecCluster_1, Index));
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->VecCluster_2, Index));
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->VecCluster_3, Index));
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data_Count(Find_ClusteringElem(clusterizator->VecCluster_4, Index));
+
+                default: break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Get the amount of data for clustering element of the specified id by its index
+uint64_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_Count_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Data_Count_By_Index(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index);
+}
+
+// Get the amount of data for all clustering elements of the specified id
+uint64_t NS_Clustering::HClusterizator_Get_All_ClusteringElem_Data_Count(HClusterizator Handle, const uint16_t ClusteringElemId) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator)
+            return clusterizator->Get_Count(ClusteringElemId, false);
     }
 
-    return 1;
+    return 0;
 }
 
-// Create set of clusters_2
-int32_t NS_Clustering::Clusterizator_Create_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2) noexcept
+// Get the amount of data for all clustering elements of the specified id
+uint64_t NS_Clustering::Clusterizator_Get_All_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept
 {
-    if (ClusterizatorId > 0)
-    {
-        auto it = MapClusterizator.find(ClusterizatorId);
+    return HClusterizator_Get_All_ClusteringElem_Data_Count(Registry.Find(ClusterizatorId).get(), ClusteringElemId);
+}
 
-        if (it != MapClusterizator.end())
-        {
-            Create_Clusters_2(it->second.MapDot, it->second.MapCluster_1, it->second.MapCluster_2, static_cast<bool>(SingleClusteringElem_To_Cluster_2));
+// Get the amount of data for all clustering elements of clusterizator
+uint64_t NS_Clustering::HClusterizator_Get_Data_Count(HClusterizator Handle) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
 
-            return 0;
-        }
+        if (clusterizator)
+            return clusterizator->Get_Count(0, true);
     }
 
-    return 1;
+    return 0;
 }
 
-// Create set of clusters_3
-int32_t NS_Clustering::Clusterizator_Create_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3) noexcept
+// Get the amount of data for all clustering elements of clusterizator
+uint64_t NS_Clustering::Clusterizator_Get_Data_Count(const uint32_t ClusterizatorId) noexcept
+{
+    return HClusterizator_Get_Data_Count(Registry.Find(ClusterizatorId).get());
+}
+
+
+// Get a set of specified clustering elements
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElems(HClusterizator Handle, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept
 {
-    if (ClusterizatorId > 0)
+    if (Handle && X_Arr && Y_Arr)
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (it != MapClusterizator.end())
+        if (clusterizator && !clusterizator->MapDot.empty())
         {
-            Create_Clusters_3(it->second.MapDot, it->second.MapCluster_1, it->second.MapCluster_2, it->second.MapCluster_3, static_cast<bool>(SingleClusteringElem_To_Cluster_3));
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElems");
 
-            return 0;
+            if (Address_Of_TagAddress_Arr) // tags can be changed by the addresses
+                clusterizator->TagIndex_Actual = false;
+
+            switch (ClusteringElemId)
+            {
+                case ID_DOT:       { Clusterizator_Get_ClusteringElems(clusterizator->MapDot, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+                case ID_CLUSTER_1: { Clusterizator_Get_ClusteringElems(clusterizator->MapCluster_1, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+                case ID_CLUSTER_2: { Clusterizator_Get_ClusteringElems(clusterizator->MapCluster_2, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+                case ID_CLUSTER_3: { Clusterizator_Get_ClusteringElems(clusterizator->MapCluster_3, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+                case ID_CLUSTER_4: { Clusterizator_Get_ClusteringElems(clusterizator->MapCluster_4, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+
+                default: break;
+            }
         }
     }
 
     return 1;
 }
 
-// Create set of clusters_4
-int32_t NS_Clustering::Clusterizator_Create_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4) noexcept
+// Get a set of specified clustering elements
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept
 {
-    if (ClusterizatorId > 0)
+    return HClusterizator_Get_ClusteringElems(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr);
+}
+
+// Get indices of specified clustering elements
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_Indices(HClusterizator Handle, const uint16_t ClusteringElemId, uint32_t* Index_Arr) noexcept
+{
+    if (Handle && Index_Arr)
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (it != MapClusterizator.end())
+        if (clusterizator && !clusterizator->MapDot.empty())
         {
-            Create_Clusters_4(it->second.MapDot, it->second.MapCluster_1, it->second.MapCluster_2, it->second.MapCluster_3, it->second.MapCluster_4, static_cast<bool>(SingleClusteringElem_To_Cluster_4));
+            switch (ClusteringElemId)
+            {
+                case ID_DOT      : { Clusterizator_Get_ClusteringElem_Indices(clusterizator->MapDot, Index_Arr); return 0; }
+                case ID_CLUSTER_1: { Clusterizator_Get_ClusteringElem_Indices(clusterizator->MapCluster_1, Index_Arr); return 0; }
+                case ID_CLUSTER_2: { Clusterizator_Get_ClusteringElem_Indices(clusterizator->MapCluster_2, Index_Arr); return 0; }
+                case ID_CLUSTER_3: { Clusterizator_Get_ClusteringElem_Indices(clusterizator->MapCluster_3, Index_Arr); return 0; }
+                case ID_CLUSTER_4: { Clusterizator_Get_ClusteringElem_Indices(clusterizator->MapCluster_4, Index_Arr); return 0; }
 
-            return 0;
+                default: break;
+            }
         }
     }
 
     return 1;
 }
 
+// Get indices of specified clustering elements
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Indices(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, uint32_t* Index_Arr) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Indices(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index_Arr);
+}
 
-// Clear all sets of clusters
-int32_t NS_Clustering::Clusterizator_Clear_Clusters(const uint32_t ClusterizatorId) noexcept
+// Get clustering elements of all specified ids which are not in any cluster
+int32_t NS_Clustering::HClusterizator_Get_Visible_ClusteringElems(HClusterizator Handle, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count) noexcept
 {
-    if (ClusterizatorId > 0)
+    Out_Count = 0;
+
+    if (Handle && (ClusteringElemId_List || ClusteringElemId_List_Size == 0))
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (it != MapClusterizator.end())
+        if (clusterizator)
         {
-            Clear_Map_Of_ClusteringElem(it->second.MapCluster_4);
-            Clear_Map_Of_ClusteringElem(it->second.MapCluster_3);
-            Clear_Map_Of_ClusteringElem(it->second.MapCluster_2);
-            Clear_Map_Of_ClusteringElem(it->second.MapCluster_1);
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_Visible_ClusteringElems");
 
-            for (auto& dot : it->second.MapDot)
-                dot.second->InCluster = false;
+            for (uint32_t i = 0; i < ClusteringElemId_List_Size; ++i)
+            {
+                const uint16_t id = ClusteringElemId_List[i];
 
-            return 0;
+                switch (id)
+                {
+                    case ID_DOT:       { Clusterizator_Get_Visible_ClusteringElems(clusterizator->MapDot, id, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count); break; }
+                    case ID_CLUSTER_1: { Clusterizator_Get_Visible_ClusteringElems(clusterizator->MapCluster_1, id, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count); break; }
+                    case ID_CLUSTER_2: { Clusterizator_Get_Visible_ClusteringElems(clusterizator->MapCluster_2, id, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count); break; }
+                    case ID_CLUSTER_3: { Clusterizator_Get_Visible_ClusteringElems(clusterizator->MapCluster_3, id, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count); break; }
+                    case ID_CLUSTER_4: { Clusterizator_Get_Visible_ClusteringElems(clusterizator->MapCluster_4, id, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count); break; }
+
+                    default: { Out_Count = 0; return 1; } // unknown id
+                }
+            }
+
+            return Out_Count <= Capacity ? 0 : 1; // 1 - arrays are too small, Out_Count is the required size
         }
     }
 
     return 1;
 }
 
-// Clear clusterizator
-int32_t NS_Clustering::Clusterizator_Clear(const uint32_t ClusterizatorId) noexcept
+// Get clustering elements of all specified ids which are not in any cluster
+int32_t NS_Clustering::Clusterizator_Get_Visible_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count) noexcept
+{
+    return HClusterizator_Get_Visible_ClusteringElems(Registry.Find(ClusterizatorId).get(), ClusteringElemId_List, ClusteringElemId_List_Size, Capacity, ClusteringElemId_Arr, X_Arr, Y_Arr, DataCount_Arr, Index_Arr, Out_Count);
+}
+
+// Get read-only arrays of clustering elements of the specified id
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_View(HClusterizator Handle, const uint16_t ClusteringElemId, TClusteringElemView& Out_View) noexcept
 {
-    if (ClusterizatorId > 0)
+    if (Handle)
     {
-        auto it = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (it != MapClusterizator.end())
+        if (clusterizator)
         {
-            it->second.Clear();
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElem_View");
 
-            return 0;
+            try
+            {
+                if (clusterizator->Get_View(ClusteringElemId, Out_View))
+                    return 0;
+            }
+            catch (...) {}
         }
     }
 
     return 1;
 }
 
+// Get read-only arrays of clustering elements of the specified id
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_View(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, TClusteringElemView& Out_View) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_View(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Out_View);
+}
 
-// Get the number of clustering elements of the specified id
-uint64_t NS_Clustering::Clusterizator_Get_ClusteringElem_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept
+// Get data for all dots for specified clustering element
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept
 {
-    if (ClusterizatorId > 0)
+    if (Handle && Data_Arr)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend())
+        if (clusterizator && !clusterizator->MapDot.empty())
         {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElem_Data");
+
             switch (ClusteringElemId)
             {
-                case ID_DOT:       return cit->second.MapDot.size();
-                case ID_CLUSTER_1: return cit->second.MapCluster_1.size();
-                case ID_CLUSTER_2: return cit->second.MapCluster_2.size();
-                case ID_CLUSTER_3: return cit->second.MapCluster_3.size();
-                case ID_CLUSTER_4: return cit->second.MapCluster_4.size();
+                case ID_DOT:       return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->MapDot, X, Y), Data_Arr);
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->MapCluster_1, X, Y), Data_Arr);
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->MapCluster_2, X, Y), Data_Arr);
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->MapCluster_3, X, Y), Data_Arr);
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->MapCluster_4, X, Y), Data_Arr);
 
                 default: break;
             }
         }
     }
 
-    return 0;
+    return 1;
 }
 
-// Get the amount of data for clustering element of the specified id
-uint64_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y) noexcept
+// Get data for all dots for specified clustering element
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept
 {
-    if (ClusterizatorId > 0)
+    return HClusterizator_Get_ClusteringElem_Data(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X, Y, Data_Arr);
+}
+
+// Get data for all dots for specified clustering element by its index
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr) noexcept
+{
+    if (Handle && Data_Arr)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend())
+        if (clusterizator)
         {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElem_Data_By_Index");
+
             switch (ClusteringElemId)
             {
-                case ID_DOT:       return Clusterizator_Get_ClusteringElem_Data_Count(cit->second.MapDot, X, Y);
-                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data_Count(cit->second.MapCluster_1, X, Y);
-                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data_Count(cit->second.MapCluster_2, X, Y);
-                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data_Count(cit->second.MapCluster_3, X, Y);
-                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data_Count(cit->second.MapCluster_4, X, Y);
+                case ID_DOT      : return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->VecDot, Index), Data_Arr);
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->VecCluster_1, Index), Data_Arr);
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->VecCluster_2, Index), Data_Arr);
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->VecCluster_3, Index), Data_Arr);
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data(Find_ClusteringElem(clusterizator->VecCluster_4, Index), Data_Arr);
 
                 default: break;
             }
         }
     }
 
-    return 0;
+    return 1;
 }
 
-// Get the amount of data for all clustering elements of the specified id
-uint64_t NS_Clustering::Clusterizator_Get_All_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept
+// Get data for all dots for specified clustering element by its index
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr) noexcept
 {
-    if (ClusterizatorId > 0)
-    {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
-
-        if (cit != MapClusterizator.cend())
-            return cit->second.Get_Count(ClusteringElemId, false);
-    }
-
-    return 0;
+    return HClusterizator_Get_ClusteringElem_Data_By_Index(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index, Data_Arr);
 }
 
-// Get the amount of data for all clustering elements of clusterizator
-uint64_t NS_Clustering::Clusterizator_Get_Data_Count(const uint32_t ClusterizatorId) noexcept
+// Get a page of data for all dots for specified clustering element
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data_Page(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept
 {
-    if (ClusterizatorId > 0)
+    if (Handle && Data_Arr && PageSize > 0)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator && !clusterizator->MapDot.empty())
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElem_Data_Page");
+
+            switch (ClusteringElemId)
+            {
+                case ID_DOT:       return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->MapDot, X, Y), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->MapCluster_1, X, Y), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->MapCluster_2, X, Y), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->MapCluster_3, X, Y), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->MapCluster_4, X, Y), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
 
-        if (cit != MapClusterizator.cend())
-            return cit->second.Get_Count(0, true);
+                default: break;
+            }
+        }
     }
 
-    return 0;
+    return 1;
 }
 
+// Get a page of data for all dots for specified clustering element
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_Page(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Data_Page(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X, Y, Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+}
 
-// Get a set of specified clustering elements
-int32_t NS_Clustering::Clusterizator_Get_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept
+
+// Get a page of data for all dots for specified clustering element by its index
+int32_t NS_Clustering::HClusterizator_Get_ClusteringElem_Data_Page_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept
 {
-    if (ClusterizatorId > 0 && X_Arr && Y_Arr)
+    if (Handle && Data_Arr && PageSize > 0)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend() && !cit->second.MapDot.empty())
+        if (clusterizator)
         {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Get_ClusteringElem_Data_Page_By_Index");
+
             switch (ClusteringElemId)
             {
-                case ID_DOT:       { Clusterizator_Get_ClusteringElems(cit->second.MapDot, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
-                case ID_CLUSTER_1: { Clusterizator_Get_ClusteringElems(cit->second.MapCluster_1, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
-                case ID_CLUSTER_2: { Clusterizator_Get_ClusteringElems(cit->second.MapCluster_2, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
-                case ID_CLUSTER_3: { Clusterizator_Get_ClusteringElems(cit->second.MapCluster_3, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
-                case ID_CLUSTER_4: { Clusterizator_Get_ClusteringElems(cit->second.MapCluster_4, X_Arr, Y_Arr, Address_Of_InCluster_Arr, Address_Of_DataCount_Arr, Address_Of_TagAddress_Arr); return 0; }
+                case ID_DOT      : return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->VecDot, Index), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->VecCluster_1, Index), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->VecCluster_2, Index), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->VecCluster_3, Index), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data_Page(Find_ClusteringElem(clusterizator->VecCluster_4, Index), Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
 
                 default: break;
             }
@@ -472,256 +3425,322 @@ int32_t NS_Clustering::Clusterizator_Get_ClusteringElems(const uint32_t Clusteri
     return 1;
 }
 
-// Get data for all dots for specified clustering element
-int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept
+// Get a page of data for all dots for specified clustering element by its index
+int32_t NS_Clustering::Clusterizator_Get_ClusteringElem_Data_Page_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept
+{
+    return HClusterizator_Get_ClusteringElem_Data_Page_By_Index(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index, Cursor, PageSize, Data_Arr, Out_Count, Out_NextCursor);
+}
+
+
+// Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
+int16_t NS_Clustering::HClusterizator_Is_ClusteringElem_Have_Tag(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept
 {
-    if (ClusterizatorId > 0 && Data_Arr)
+    if (Handle)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend() && !cit->second.MapDot.empty())
+        if (clusterizator)
         {
-            switch (ClusteringElemId)
-            {
-                case ID_DOT:       return Clusterizator_Get_ClusteringElem_Data(cit->second.MapDot, X, Y, Data_Arr);
-                case ID_CLUSTER_1: return Clusterizator_Get_ClusteringElem_Data(cit->second.MapCluster_1, X, Y, Data_Arr);
-                case ID_CLUSTER_2: return Clusterizator_Get_ClusteringElem_Data(cit->second.MapCluster_2, X, Y, Data_Arr);
-                case ID_CLUSTER_3: return Clusterizator_Get_ClusteringElem_Data(cit->second.MapCluster_3, X, Y, Data_Arr);
-                case ID_CLUSTER_4: return Clusterizator_Get_ClusteringElem_Data(cit->second.MapCluster_4, X, Y, Data_Arr);
+            const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, X, Y); // find specified clustering element
 
-                default: break;
-            }
+            if (elem) // found
+                return elem->Tag == Tag ? 1 : 0;
         }
     }
 
-    return 1;
+    return 0;
 }
 
-
 // Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
 int16_t NS_Clustering::Clusterizator_Is_ClusteringElem_Have_Tag(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept
 {
-    if (ClusterizatorId > 0)
+    return HClusterizator_Is_ClusteringElem_Have_Tag(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X, Y, Tag);
+}
+
+// Does the specified clustering element contain the specified tag by its index (1 - yes, 0 - no)
+int16_t NS_Clustering::HClusterizator_Is_ClusteringElem_Have_Tag_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept
+{
+    if (Handle)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend() && !cit->second.MapDot.empty())
+        if (clusterizator)
         {
-            switch (ClusteringElemId)
-            {
-                case ID_DOT:       return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapDot, X, Y, Tag);
-                case ID_CLUSTER_1: return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapCluster_1, X, Y, Tag);
-                case ID_CLUSTER_2: return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapCluster_2, X, Y, Tag);
-                case ID_CLUSTER_3: return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapCluster_3, X, Y, Tag);
-                case ID_CLUSTER_4: return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapCluster_4, X, Y, Tag);
+            const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, Index); // O(1)
 
-                default: break;
-            }
+            if (elem) // found
+                return elem->Tag == Tag ? 1 : 0;
         }
     }
 
     return 0;
 }
 
-/*** Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no) ***/
-namespace NS_Clustering
+// Does the specified clustering element contain the specified tag by its index (1 - yes, 0 - no)
+int16_t NS_Clustering::Clusterizator_Is_ClusteringElem_Have_Tag_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept
+{
+    return HClusterizator_Is_ClusteringElem_Have_Tag_By_Index(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index, Tag);
+}
+
+// Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
+int16_t NS_Clustering::HClusterizator_Is_ClusteringElem_Have_Tag_Inside(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept
 {
-    int16_t Clusterizator_Is_MapDot_Have_Tag_Inside(const TMapCDot& MapDot, const uint64_t Tag) noexcept
+    if (Handle)
     {
-        for (const auto& dot : MapDot)
+        TLockedClusterizator clusterizator(Handle);
+
+        if (clusterizator && !clusterizator->MapDot.empty())
         {
-            if (dot.second->Tag == Tag)
-                return 1;
-        }
+            const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, X, Y); // find specified clustering element
 
-        return 0;
+            if (elem) // found
+                return clusterizator->Is_Have_Tag_Inside(elem, Tag) ? 1 : 0;
+        }
     }
 
-    int16_t Clusterizator_Is_MapCluster_1_Have_Tag_Inside(const TMapCCluster_1& MapCluster_1, const uint64_t Tag) noexcept
+    return 0;
+}
+
+// Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
+int16_t NS_Clustering::Clusterizator_Is_ClusteringElem_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept
+{
+    return HClusterizator_Is_ClusteringElem_Have_Tag_Inside(Registry.Find(ClusterizatorId).get(), ClusteringElemId, X, Y, Tag);
+}
+
+// Does the specified clustering element contain the specified tag among all its clustering elements by its index (1 - yes, 0 - no)
+int16_t NS_Clustering::HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept
+{
+    if (Handle)
     {
-        int16_t tag_found = 0;
+        TLockedClusterizator clusterizator(Handle);
 
-        for (const auto& c1 : MapCluster_1)
+        if (clusterizator)
         {
-            if (c1.second->Tag == Tag)
-                tag_found = 1;
-            else
-                tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(c1.second->MapDot, Tag);
+            const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, Index); // O(1)
 
-            if (tag_found == 1)
-                break;
+            if (elem) // found
+                return clusterizator->Is_Have_Tag_Inside(elem, Tag) ? 1 : 0;
         }
-
-        return tag_found;
     }
 
-    int16_t Clusterizator_Is_MapCluster_2_Have_Tag_Inside(const TMapCCluster_2& MapCluster_2, const uint64_t Tag) noexcept
+    return 0;
+}
+
+// Does the specified clustering element contain the specified tag among all its clustering elements by its index (1 - yes, 0 - no)
+int16_t NS_Clustering::Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept
+{
+    return HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index(Registry.Find(ClusterizatorId).get(), ClusteringElemId, Index, Tag);
+}
+
+// Does each of the specified clustering elements contain the specified tag among all its clustering elements
+int32_t NS_Clustering::HClusterizator_Is_ClusteringElems_Have_Tag_Inside(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr) noexcept
+{
+    if (Handle && X_Arr && Y_Arr && Result_Arr)
     {
-        int16_t tag_found = 0;
+        TLockedClusterizator clusterizator(Handle);
 
-        for (const auto& c2 : MapCluster_2)
+        if (clusterizator)
         {
-            if (c2.second->Tag == Tag)
-                tag_found = 1;
-            else
+            try
             {
-                tag_found = Clusterizator_Is_MapCluster_1_Have_Tag_Inside(c2.second->MapCluster_1, Tag);
+                if (clusterizator->TagIndex_Enabled)
+                {
+                    std::unordered_set<const TClusteringElem*> set_elem_with_tag; // all clustering elements that have the tag inside
 
-                if (tag_found != 1)
-                    tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(c2.second->MapDot, Tag);
-            }
+                    clusterizator->Get_TagIndex().Get_Elems_With_Tag_Inside(Tag, set_elem_with_tag);
 
-            if (tag_found == 1)
-                break;
-        }
+                    for (uint32_t i = 0; i < ArrSize; ++i)
+                    {
+                        const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, X_Arr[i], Y_Arr[i]);
 
-        return tag_found;
-    }
+                        Result_Arr[i] = elem && set_elem_with_tag.count(elem) > 0 ? 1 : 0;
+                    }
 
-    int16_t Clusterizator_Is_MapCluster_3_Have_Tag_Inside(const TMapCCluster_3& MapCluster_3, const uint64_t Tag) noexcept
-    {
-        int16_t tag_found = 0;
+                    return 0;
+                }
+            }
+            catch (...) {} // no memory for the index of tags, clustering elements are walked
 
-        for (const auto& c3 : MapCluster_3)
-        {
-            if (c3.second->Tag == Tag)
-                tag_found = 1;
-            else
+            for (uint32_t i = 0; i < ArrSize; ++i)
             {
-                tag_found = Clusterizator_Is_MapCluster_2_Have_Tag_Inside(c3.second->MapCluster_2, Tag);
-
-                if (tag_found != 1)
-                    tag_found = Clusterizator_Is_MapCluster_1_Have_Tag_Inside(c3.second->MapCluster_1, Tag);
+                const TClusteringElem* const elem = clusterizator->Find_ClusteringElem(ClusteringElemId, X_Arr[i], Y_Arr[i]);
 
-                if (tag_found != 1)
-                    tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(c3.second->MapDot, Tag);
+                Result_Arr[i] = elem && Is_Have_Tag_Inside_By_Walk(elem, Tag) ? 1 : 0;
             }
 
-            if (tag_found == 1)
-                break;
+            return 0;
         }
-
-        return tag_found;
     }
+
+    return 1;
 }
 
-int16_t NS_Clustering::Clusterizator_Is_ClusteringElem_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept
+// Does each of the specified clustering elements contain the specified tag among all its clustering elements
+int32_t NS_Clustering::Clusterizator_Is_ClusteringElems_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr) noexcept
+{
+    return HClusterizator_Is_ClusteringElems_Have_Tag_Inside(Registry.Find(ClusterizatorId).get(), ClusteringElemId, ArrSize, X_Arr, Y_Arr, Tag, Result_Arr);
+}
+
+// Notify that tags were changed by the addresses of tags
+int32_t NS_Clustering::HClusterizator_Tags_Changed(HClusterizator Handle) noexcept
 {
-    if (ClusterizatorId > 0)
+    if (Handle)
     {
-        const auto cit = MapClusterizator.find(ClusterizatorId);
+        TLockedClusterizator clusterizator(Handle);
 
-        if (cit != MapClusterizator.cend() && !cit->second.MapDot.empty())
+        if (clusterizator)
         {
-            switch (ClusteringElemId)
-            {
-                case ID_DOT: return Clusterizator_Is_ClusteringElem_Have_Tag(cit->second.MapDot, X, Y, Tag);
+            clusterizator->TagIndex_Actual  = false;
+            clusterizator->TagIndex_Enabled = true; // the caller notifies about changes of tags
 
-                case ID_CLUSTER_1:
-                {
-                    const auto cit_c1 = cit->second.MapCluster_1.find(TCoordKey(X, Y)); // find specified cluster_1
+            return 0;
+        }
+    }
 
-                    if (cit_c1 != cit->second.MapCluster_1.cend()) // found
-                    {
-                        int16_t tag_found = 0;
+    return 1;
+}
 
-                        if (cit_c1->second->Tag == Tag)
-                            tag_found = 1;
-                        else
-                            tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(cit_c1->second->MapDot, Tag);
+// Notify that tags were changed by the addresses of tags
+int32_t NS_Clustering::Clusterizator_Tags_Changed(const uint32_t ClusterizatorId) noexcept
+{
+    return HClusterizator_Tags_Changed(Registry.Find(ClusterizatorId).get());
+}
 
-                        return tag_found;
-                    }
+// Get instrumentation counters of the last creation of clusters_1..4
+int32_t NS_Clustering::HClusterizator_Get_Stats(HClusterizator Handle, TStats* Out_Stats_Arr) noexcept
+{
+    #if defined(SIMPLE_CLUSTERING_STATS)
+      if (Handle && Out_Stats_Arr)
+      {
+          TLockedClusterizator clusterizator(Handle);
+
+          if (clusterizator)
+          {
+              std::copy(clusterizator->Stats, clusterizator->Stats + 4, Out_Stats_Arr);
+
+              return 0;
+          }
+      }
+    #else
+      (void)Handle;
+      (void)Out_Stats_Arr;
+    #endif
 
-                    break;
-                }
+    return 1;
+}
 
-                case ID_CLUSTER_2:
-                {
-                    const auto cit_c2 = cit->second.MapCluster_2.find(TCoordKey(X, Y)); // find specified cluster_2
+// Get instrumentation counters of the last creation of clusters_1..4
+int32_t NS_Clustering::Clusterizator_Get_Stats(const uint32_t ClusterizatorId, TStats* Out_Stats_Arr) noexcept
+{
+    return HClusterizator_Get_Stats(Registry.Find(ClusterizatorId).get(), Out_Stats_Arr);
+}
 
-                    if (cit_c2 != cit->second.MapCluster_2.cend()) // found
-                    {
-                        int16_t tag_found = 0;
+// Start recording of the timeline
+int32_t NS_Clustering::HClusterizator_Start_Trace(HClusterizator Handle) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
 
-                        if (cit_c2->second->Tag == Tag)
-                            tag_found = 1;
-                        else
-                        {
-                            tag_found = Clusterizator_Is_MapCluster_1_Have_Tag_Inside(cit_c2->second->MapCluster_1, Tag);
+        if (clusterizator)
+        {
+            try
+            {
+                clusterizator->Trace.reset(new TTrace());
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(cit_c2->second->MapDot, Tag);
-                        }
+                return 0;
+            }
+            catch (...) {}
+        }
+    }
 
-                        return tag_found;
-                    }
+    return 1;
+}
 
-                    break;
-                }
+// Start recording of the timeline
+int32_t NS_Clustering::Clusterizator_Start_Trace(const uint32_t ClusterizatorId) noexcept
+{
+    return HClusterizator_Start_Trace(Registry.Find(ClusterizatorId).get());
+}
 
-                case ID_CLUSTER_3:
-                {
-                    const auto cit_c3 = cit->second.MapCluster_3.find(TCoordKey(X, Y)); // find specified cluster_3
+// Stop recording of the timeline and write it to the file
+int32_t NS_Clustering::HClusterizator_Stop_Trace(HClusterizator Handle, const char* FileName) noexcept
+{
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
 
-                    if (cit_c3 != cit->second.MapCluster_3.cend()) // found
-                    {
-                        int16_t tag_found = 0;
+        if (clusterizator && clusterizator->Trace)
+        {
+            const std::unique_ptr<TTrace> trace(std::move(clusterizator->Trace));
 
-                        if (cit_c3->second->Tag == Tag)
-                            tag_found = 1;
-                        else
-                        {
-                            tag_found = Clusterizator_Is_MapCluster_2_Have_Tag_Inside(cit_c3->second->MapCluster_2, Tag);
+            return !FileName || trace->Write(FileName) ? 0 : 1;
+        }
+    }
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapCluster_1_Have_Tag_Inside(cit_c3->second->MapCluster_1, Tag);
+    return 1;
+}
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(cit_c3->second->MapDot, Tag);
-                        }
+// Stop recording of the timeline and write it to the file
+int32_t NS_Clustering::Clusterizator_Stop_Trace(const uint32_t ClusterizatorId, const char* FileName) noexcept
+{
+    return HClusterizator_Stop_Trace(Registry.Find(ClusterizatorId).get(), FileName);
+}
 
-                        return tag_found;
-                    }
+// Get the memory of the clusterizator in bytes
+int32_t NS_Clustering::HClusterizator_Get_Memory_Usage(HClusterizator Handle, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes) noexcept
+{
+    Out_Total_Bytes = 0;
 
-                    break;
-                }
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
 
-                case ID_CLUSTER_4:
-                {
-                    const auto cit_c4 = cit->second.MapCluster_4.find(TCoordKey(X, Y)); // find specified cluster_4
+        if (clusterizator)
+        {
+            Out_Total_Bytes = clusterizator->Get_Memory_Usage(Out_Usage_Arr);
 
-                    if (cit_c4 != cit->second.MapCluster_4.cend()) // found
-                    {
-                        int16_t tag_found = 0;
+            return 0;
+        }
+    }
 
-                        if (cit_c4->second->Tag == Tag)
-                            tag_found = 1;
-                        else
-                        {
-                            tag_found = Clusterizator_Is_MapCluster_3_Have_Tag_Inside(cit_c4->second->MapCluster_3, Tag);
+    return 1;
+}
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapCluster_2_Have_Tag_Inside(cit_c4->second->MapCluster_2, Tag);
+// Get the memory of the clusterizator in bytes
+int32_t NS_Clustering::Clusterizator_Get_Memory_Usage(const uint32_t ClusterizatorId, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes) noexcept
+{
+    return HClusterizator_Get_Memory_Usage(Registry.Find(ClusterizatorId).get(), Out_Usage_Arr, Out_Total_Bytes);
+}
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapCluster_1_Have_Tag_Inside(cit_c4->second->MapCluster_1, Tag);
+// Reclaim values of changed datasets of dots in the arena
+int32_t NS_Clustering::HClusterizator_Compact_Dot_Data(HClusterizator Handle, uint64_t& Out_FreedBytes) noexcept
+{
+    Out_FreedBytes = 0;
 
-                            if (tag_found != 1)
-                                tag_found = Clusterizator_Is_MapDot_Have_Tag_Inside(cit_c4->second->MapDot, Tag);
-                        }
+    if (Handle)
+    {
+        TLockedClusterizator clusterizator(Handle);
 
-                        return tag_found;
-                    }
+        if (clusterizator)
+        {
+            TTraceScope trace_scope(clusterizator->Trace.get(), "Clusterizator_Compact_Dot_Data");
 
-                    break;
-                }
+            try
+            {
+                Out_FreedBytes = clusterizator->Compact_Dot_Data(true);
 
-                default: break;
+                return 0;
             }
+            catch (...) {}
         }
     }
 
-    return 0;
+    return 1;
+}
+
+// Reclaim values of changed datasets of dots in the arena
+int32_t NS_Clustering::Clusterizator_Compact_Dot_Data(const uint32_t ClusterizatorId, uint64_t& Out_FreedBytes) noexcept
+{
+    return HClusterizator_Compact_Dot_Data(Registry.Find(ClusterizatorId).get(), Out_FreedBytes);
 }
-/***************************************************************************************************************************/
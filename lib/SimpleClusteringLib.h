@@ -16,44 +16,260 @@
 #include "SimpleClustering.h"
 
 #include <map>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 
 #include <cstdint>
 
+// Exported functions and variables of the library, the rest of symbols are hidden when building the shared object
+#if defined(_WIN32)
+  #define SIMPLE_CLUSTERING_EXPORT __declspec(dllexport)
+#else
+  #define SIMPLE_CLUSTERING_EXPORT __attribute__((visibility("default")))
+#endif
+
 namespace NS_Clustering
 {
     // Cluster object identifiers
-    extern "C" __declspec(dllexport) const uint16_t  ID_DOT_;
-    extern "C" __declspec(dllexport) const uint16_t  ID_CLUSTER_1_;
-    extern "C" __declspec(dllexport) const uint16_t  ID_CLUSTER_2_;
-    extern "C" __declspec(dllexport) const uint16_t  ID_CLUSTER_3_;
-    extern "C" __declspec(dllexport) const uint16_t  ID_CLUSTER_4_;
-
-    extern "C" __declspec(dllexport) const double  Dot_Radius_;
-    extern "C" __declspec(dllexport) const double  Cluster_1_Radius_;
-    extern "C" __declspec(dllexport) const double  Cluster_2_Radius_;
-    extern "C" __declspec(dllexport) const double  Cluster_3_Radius_;
-    extern "C" __declspec(dllexport) const double  Cluster_4_Radius_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const uint16_t  ID_DOT_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const uint16_t  ID_CLUSTER_1_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const uint16_t  ID_CLUSTER_2_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const uint16_t  ID_CLUSTER_3_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const uint16_t  ID_CLUSTER_4_;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double  Dot_Radius_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double  Cluster_1_Radius_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double  Cluster_2_Radius_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double  Cluster_3_Radius_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double  Cluster_4_Radius_;
 
     /* An additional part of the radius - is added to the radius of the clustering object when checking the possibility of merging.
     It may be necessary when graphically displaying clustering elements so that it does not seem that the center of any element
     located on the edge of another element. */
-    extern "C" __declspec(dllexport) const double AdditionalRadiusValue_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const double AdditionalRadiusValue_;
 
     // Whether to use the additional part of the radius when checking the possibility of merging clustering objects
-    extern "C" __declspec(dllexport) const int16_t Use_AdditionalRadiusValue_;
+    extern "C" SIMPLE_CLUSTERING_EXPORT const int16_t Use_AdditionalRadiusValue_;
+
+
+    /* Columnar point file: header, then arrays of X coordinates (double), Y coordinates (double) and, if Data_Offset is not 0,
+    data of points (uint64_t), Count elements each. Values have the native byte order, arrays are aligned to 8 bytes. */
+    static const char      Point_File_Magic[8]  = { 'S', 'C', 'L', 'P', 'N', 'T', 'S', '\0' };
+    static const uint32_t  Point_File_Version   = 1;
+
+    struct TPointFileHeader
+    {
+        char      Magic[8];     // Point_File_Magic
+        uint32_t  Version;      // Point_File_Version
+        uint32_t  HeaderSize;   // size of the header
+        uint64_t  Count;        // number of points
+        uint64_t  X_Offset;     // position of the array of X coordinates in the file
+        uint64_t  Y_Offset;     // position of the array of Y coordinates in the file
+        uint64_t  Data_Offset;  // position of the array of data in the file (0 - points without data)
+    };
+
+    class TMappedFile // read-only mapping of a file into memory
+    {
+    private:
+        const uint8_t*  Data;  // mapped contents of the file
+        std::size_t     Size;  // size of the file
+
+    public:
+        TMappedFile(void) noexcept;
+        TMappedFile(const TMappedFile&) = delete;
+        TMappedFile& operator = (const TMappedFile&) = delete;
+        ~TMappedFile(void) noexcept;
+
+        // Map the file into memory (false - the file cannot be opened or mapped)
+        bool Open(const char* const FileName) noexcept;
+
+        // Unmap the file
+        void Close(void) noexcept;
+
+        // Get the contents of the file
+        const uint8_t* Get_Data(void) const noexcept;
+
+        // Get the size of the file
+        std::size_t Get_Size(void) const noexcept;
+    };
+
+    struct TClusteringElemView // read-only arrays of clustering elements of one id in the order of their indices
+    {
+        uint32_t         Count;             // number of elements
+        const double*    X_Arr;             // X coordinates of centers
+        const double*    Y_Arr;             // Y coordinates of centers
+        const uint64_t*  DataCount_Arr;     // amount of data
+        const uint64_t*  DotCount_Arr;      // number of dots
+        const uint16_t*  Parent_Id_Arr;     // id of the cluster that contains the element (ID_BASE_CLASS - not in any cluster)
+        const uint32_t*  Parent_Index_Arr;  // index of the cluster that contains the element (INDEX_NONE - not in any cluster)
+        const uint8_t*   Selected_Arr;      // whether the element takes part in clustering (0 - the dot is out of the selection and is not shown)
+    };
+
+    class TClusteringElemArrays // contiguous arrays of clustering elements of one id, they are given out as a view
+    {
+    private:
+        std::vector<double>    X_Arr;
+        std::vector<double>    Y_Arr;
+        std::vector<uint64_t>  DataCount_Arr;
+        std::vector<uint64_t>  DotCount_Arr;
+        std::vector<uint16_t>  Parent_Id_Arr;
+        std::vector<uint32_t>  Parent_Index_Arr;
+        std::vector<uint8_t>   Selected_Arr;
+
+    public:
+        bool Actual; // whether arrays correspond to the current clustering elements
+
+
+        TClusteringElemArrays(void) noexcept;
+
+        // Fill arrays from the dense array of clustering elements, the memory of arrays is reused
+        template <typename Type> void Build(const std::vector<Type*>& VecClusteringElem)
+        {
+            const std::size_t size = VecClusteringElem.size();
+
+            X_Arr.resize(size);
+            Y_Arr.resize(size);
+            DataCount_Arr.resize(size);
+            DotCount_Arr.resize(size);
+            Parent_Id_Arr.resize(size);
+            Parent_Index_Arr.resize(size);
+            Selected_Arr.resize(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const Type* const             ce      = VecClusteringElem[i];
+                const TClusteringElem* const  parent  = ce->Parent;
+
+                X_Arr[i]             = ce->X;
+                Y_Arr[i]             = ce->Y;
+                DataCount_Arr[i]     = ce->Get_Count();
+                DotCount_Arr[i]      = ce->Get_Dot_Count();
+                Parent_Id_Arr[i]     = parent ? parent->Get_ClusteringElem_Id() : ID_BASE_CLASS;
+                Parent_Index_Arr[i]  = parent ? parent->Index : INDEX_NONE;
+                Selected_Arr[i]      = ce->Selected ? 1 : 0;
+            }
+
+            Actual = true;
+        }
+
+        // Get the view of arrays
+        TClusteringElemView Get_View(void) const noexcept;
+
+        // Get the memory of arrays in bytes
+        std::size_t Get_Memory_Usage(void) const noexcept;
+    };
 
+    struct TMemoryUsage // memory of clustering elements of one id in bytes
+    {
+        uint64_t  Count;         // number of elements
+        uint64_t  Elem_Bytes;    // objects of elements
+        uint64_t  Map_Bytes;     // nodes of the set of elements
+        uint64_t  Index_Bytes;   // dense array of elements by their indices
+        uint64_t  Member_Bytes;  // dots: own buffers of datasets and blocks of datasets loaded by arrays, clusters: maps of members
+        uint64_t  View_Bytes;    // arrays of the view
+        uint64_t  Total_Bytes;   // all memory of elements
+    };
+
+    // Get the memory of clustering elements of one id
+    template <typename Type> TMemoryUsage Get_Memory_Usage(const std::map<TCoordKey, Type*>& MapClusteringElem, const std::vector<Type*>& VecClusteringElem, const TClusteringElemArrays& Arrays) noexcept
+    {
+        TMemoryUsage usage;
+
+        usage.Count         = MapClusteringElem.size();
+        usage.Elem_Bytes    = MapClusteringElem.size() * sizeof(Type);
+        usage.Map_Bytes     = Map_Get_Memory_Usage(MapClusteringElem);
+        usage.Index_Bytes   = VecClusteringElem.capacity() * sizeof(Type*);
+        usage.Member_Bytes  = 0;
+        usage.View_Bytes    = Arrays.Get_Memory_Usage();
+
+        for (const auto& ce : MapClusteringElem)
+            usage.Member_Bytes += ce.second->Get_Member_Memory_Usage();
+
+        usage.Total_Bytes = usage.Elem_Bytes + usage.Map_Bytes + usage.Index_Bytes + usage.Member_Bytes + usage.View_Bytes;
+
+        return usage;
+    }
+
+    /* Times of timed dots of the sliding window: the latest time of each dot and the queue of times with the earliest on top. A
+    dot that receives a later time stays in the queue with the old time too, such an entry is skipped when it comes out. */
+    class TDotTimeWindow
+    {
+    private:
+        struct TEntry
+        {
+            int64_t  Time;
+            TDot*    Dot;
+
+            bool operator > (const TEntry& Obj) const noexcept { return Time > Obj.Time; }
+        };
+
+        std::unordered_map<const TDot*, int64_t>                                MapTime;  // the latest time of each timed dot
+        std::priority_queue<TEntry, std::vector<TEntry>, std::greater<TEntry>>  Queue;    // times of dots, the earliest on top
+
+    public:
+        // Set the time of the dot, the latest of its times is kept
+        void Set_Time(TDot* const Dot, const int64_t Time);
+
+        // Whether the dot has time
+        bool Is_Timed(const TDot* const Dot) const noexcept;
+
+        // Take out the dots whose latest time is earlier than Min_Time, they are added to VecExpired in the order of time
+        void Take_Expired(const int64_t Min_Time, std::vector<TDot*>& VecExpired);
+
+        // Forget all times
+        void Clear(void) noexcept;
+
+        // Get the memory of times in bytes
+        std::size_t Get_Memory_Usage(void) const noexcept;
+    };
 
     class TClusterizator
     {
     public:
         uint32_t Id;
 
+        std::mutex Mutex; // lock of calls of the C API for the clusterizator (TLockedClusterizator)
+
         TMapDot        MapDot;        // dots
         TMapCluster_1  MapCluster_1;  // clusters_1
         TMapCluster_2  MapCluster_2;  // clusters_2
         TMapCluster_3  MapCluster_3;  // clusters_3
         TMapCluster_4  MapCluster_4;  // clusters_4
 
+        // Clustering elements by their indices
+        TVecDot        VecDot;        // dots
+        TVecCluster_1  VecCluster_1;  // clusters_1
+        TVecCluster_2  VecCluster_2;  // clusters_2
+        TVecCluster_3  VecCluster_3;  // clusters_3
+        TVecCluster_4  VecCluster_4;  // clusters_4
+
+        TDotDataArena DataArena; // storage of datasets of dots loaded by arrays
+
+        std::unique_ptr<TMappedFile> Snapshot; // loaded snapshot, datasets of dots refer to it
+
+        TDotTimeWindow TimeWindow; // times of dots added by Clusterizator_Append_Timed_Dots, other dots do not expire
+
+        TTagIndex  TagIndex;          // index of tags, used only after Clusterizator_Tags_Changed was called
+        bool       TagIndex_Actual;   // whether the index of tags corresponds to the current clustering elements and their tags
+        bool       TagIndex_Enabled;  // whether the caller notifies about changes of tags, otherwise clustering elements are walked
+
+        TStats Stats[4]; // instrumentation counters of the last creation of clusters_1..4
+
+        std::unique_ptr<TTrace> Trace; // timeline of the clusterizator between Clusterizator_Start_Trace and Clusterizator_Stop_Trace
+
+        // Arrays of clustering elements of each id for views, they are rebuilt on request after changes
+        TClusteringElemArrays  ArraysDot;
+        TClusteringElemArrays  ArraysCluster_1;
+        TClusteringElemArrays  ArraysCluster_2;
+        TClusteringElemArrays  ArraysCluster_3;
+        TClusteringElemArrays  ArraysCluster_4;
+
 
         TClusterizator(void) noexcept;
         explicit TClusterizator(const uint32_t Id_) noexcept;
@@ -62,86 +278,301 @@ namespace NS_Clustering
         // Clear all data
         void Clear(void) noexcept;
 
+        // Clear all sets of clusters, dots remain
+        void Clear_Clusters(void) noexcept;
+
+        /* Move datasets of dots that refer to the arena into one new block and free the old blocks (Force: false - only if the
+        arena has doubled since the last compaction). Must be called after dots are loaded. Returns the number of freed bytes. */
+        uint64_t Compact_Dot_Data(const bool Force);
+
+        /* Add timed dots, the dot with the same coordinates receives the data and, if it is timed, the later time. Datasets of
+        timed dots are not placed in the arena, so their memory is freed when they expire. Invalid coordinates are skipped. A new
+        dot joins the nearest existing cluster of the lowest level that can contain it, such clusters are moved to new centers. */
+        void Append_Timed_Dots(const uint32_t ArrSize, const double* const X_Arr, const double* const Y_Arr, const int64_t* const Time_Arr, const uint64_t* const Data_Arr);
+
+        /* Delete timed dots whose latest time is earlier than Min_Time in the order of time, the last dots take indices of the
+        deleted ones. Deleted dots are removed from their clusters: clusters left with fewer than two members are deleted (their
+        members go to the cluster that contained them, otherwise free dots join the nearest clusters), the rest are moved to new
+        centers, a cluster moved to the center of another one is absorbed by it. Returns the number of deleted dots. */
+        uint32_t Expire_Dots(const int64_t Min_Time);
+
         // Get the amount of data
         std::size_t Get_Count(const uint16_t ClusteringElemId, bool All) const noexcept;
+
+        // Find clustering element of the specified id by its coordinates
+        const TClusteringElem* Find_ClusteringElem(const uint16_t ClusteringElemId, const double X, const double Y) const noexcept;
+
+        // Find clustering element of the specified id by its index
+        const TClusteringElem* Find_ClusteringElem(const uint16_t ClusteringElemId, const uint32_t Index) const noexcept;
+
+        // Get the index of tags, it is rebuilt if it is not actual
+        const TTagIndex& Get_TagIndex(void);
+
+        // Does the clustering element or any clustering element inside it have the tag, by the index of tags if it is enabled
+        bool Is_Have_Tag_Inside(const TClusteringElem* const ClusteringElem, const uint64_t Tag) noexcept;
+
+        // Mark arrays of views of all clustering elements as not actual, must be called after any change of clustering elements
+        void Views_Changed(void) noexcept;
+
+        /* Get the view of arrays of clustering elements of the specified id, arrays are rebuilt if they are not actual (false -
+        unknown id). The view stays valid until the next change of clustering elements. */
+        bool Get_View(const uint16_t ClusteringElemId, TClusteringElemView& View);
+
+        /* Get the memory of the clusterizator in bytes: the total and, if Usage_Arr is not nullptr, of dots and clusters_1..4 in
+        Usage_Arr of 5 elements. The total includes the index of tags; the mapped snapshot file is not counted. */
+        uint64_t Get_Memory_Usage(TMemoryUsage* const Usage_Arr) const noexcept;
+
+        /* Save dots, their data and tags and all sets of clusters with their contents to the binary snapshot file in one pass.
+        Elements are saved in the order of their indices. */
+        bool Save_Snapshot(const char* const FileName) const;
+
+        /* Replace all data by the contents of the snapshot file. The file is mapped into memory: records are read in place and
+        datasets of dots refer to the mapped data without copying, so the file stays mapped until the clusterizator is cleared.
+        The snapshot is loaded into a separate clusterizator first, so the current data remains if the file is not valid. */
+        bool Load_Snapshot(const char* const FileName);
+
+        // Load the contents of the snapshot file into the empty clusterizator (false - the file is not a valid snapshot)
+        bool Read_Snapshot(const char* const FileName);
+
+        /* Load dots from the columnar point file, existing dots are replaced or, if Append, remain. Arrays are read directly from
+        the mapped file and are checked in parallel parts, points with NaN or infinite coordinates are skipped and counted. */
+        bool Load_Point_File(const char* const FileName, const bool Append, uint64_t& Out_RejectedCount);
+
+        /* Load dots from the CSV file: numbers of columns start from 0, Data_Column < 0 - points without data. The file is read by
+        chunks and points are loaded by batches, so the memory does not depend on the size of the file; bad lines are counted. */
+        bool Load_CSV_File(const char* const FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const bool Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+
+        /* Load dots from "coordinates" of the GeoJSON file, geometries other than points are skipped. Data of the dot is the
+        number of its "coordinates" member in the file from 0, members of skipped geometries are counted too (in a collection of
+        features with one geometry each it is the number of the feature). The file is read by chunks as the CSV file. */
+        bool Load_GeoJSON_File(const char* const FileName, const bool Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+    };
+
+    // Control block of shared_ptr created by make_shared besides the object: the table of virtual functions and 2 counters
+    static const std::size_t Shared_Block_Overhead = sizeof(void*) + sizeof(uint32_t) * 2;
+
+    /* Registry of clusterizators. Ids are not reused. Clusterizators are distributed by shards with own locks, so the registry is
+    locked only for the search of the clusterizator and calls for different clusterizators run in parallel. Calls by the id hold
+    the clusterizator by shared_ptr until their end. Calls by the handle do not hold it, so the deletion locks the clusterizator
+    before releasing it and waits for the end of the call by the handle that has already locked it. */
+    class TClusterizatorRegistry
+    {
+    public:
+        using TMap = std::map<uint32_t, std::shared_ptr<TClusterizator>>;
+
+    private:
+        static const uint32_t Shard_Count = 16;
+
+        struct TShard
+        {
+            mutable std::mutex  Mutex;
+            TMap                MapClusterizator;  // clusterizators with ids of the shard
+        };
+
+        TShard                 Shards[Shard_Count];
+        std::atomic<uint32_t>  Last_Id;  // id of the last created clusterizator
+
+    public:
+        TClusterizatorRegistry(void) noexcept;
+        TClusterizatorRegistry(const TClusterizatorRegistry&) = delete;
+        TClusterizatorRegistry& operator = (const TClusterizatorRegistry&) = delete;
+
+        // Create a new clusterizator (0 - ids are exhausted or there is no memory)
+        uint32_t New(void) noexcept;
+
+        // Delete clusterizator (false - there is no such clusterizator)
+        bool Delete(const uint32_t Id) noexcept;
+
+        // Delete all clusterizators
+        void Delete_All(void) noexcept;
+
+        // Find clusterizator (nullptr - there is no such clusterizator)
+        std::shared_ptr<TClusterizator> Find(const uint32_t Id) const noexcept;
+
+        /* Lock the clusterizator if it is in the registry (false - it is not), all shards are searched (for checking of handles).
+        It is locked under the lock of its shard, so it cannot be deleted between the check and the lock. */
+        bool Lock_If_Contains(TClusterizator* const Clusterizator, std::unique_lock<std::mutex>& Lock) const noexcept;
     };
 
-    using TMapClusterizator = std::map<uint32_t, TClusterizator>; // clusterizators
+    extern TClusterizatorRegistry Registry; // clusterizators
+
+    /* Handle of the clusterizator for calls without the search in the registry. It is valid until the clusterizator is deleted and
+    must not be used after that, for callers it is an opaque pointer. */
+    using HClusterizator = TClusterizator*;
+
+    /* Clusterizator of the handle, it is locked for the calling thread until the end of the scope. If the library is built with
+    SIMPLE_CLUSTERING_CHECK_HANDLES, the handle of a deleted clusterizator or not a handle is treated as nullptr. */
+    class TLockedClusterizator
+    {
+    private:
+        TClusterizator*               Clusterizator;
+        std::unique_lock<std::mutex>  Lock;
+
+    public:
+        explicit TLockedClusterizator(const HClusterizator Handle) noexcept;
+        TLockedClusterizator(const TLockedClusterizator&) = delete;
+        TLockedClusterizator& operator = (const TLockedClusterizator&) = delete;
+
+        // Whether the clusterizator is found
+        explicit operator bool(void) const noexcept;
+
+        TClusterizator* operator -> (void) const noexcept;
+        TClusterizator& operator * (void) const noexcept;
+    };
 
-    extern TMapClusterizator MapClusterizator; // clusterizators
+    /* Function that is called by Clusterizator_Create_Clusters_Progressive when a set of clusters is ready: ClusteringElemId - id
+    of the clusters, Final - 0 for the coarse preview, 1 for the exact set. The clusterizator is not locked during the call, so the
+    set can be read by functions of the library. Return 0 to continue or 1 to stop the refinement. If the callback deletes the
+    clusterizator, the memory stays valid until Clusterizator_Create_Clusters_Progressive returns, and it returns 1. */
+    using TLevelReadyCallback = int32_t (*)(void* Context, const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const int16_t Final);
 
 
     // Reset radius of all clustering elements to default values
-    extern "C" __declspec(dllexport) void ClusteringElems_Set_Default_Radius(void) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT void ClusteringElems_Set_Default_Radius(void) noexcept;
 
-    // Set the radius of all clustering elements
-    extern "C" __declspec(dllexport) int32_t ClusteringElems_Set_Radius(const double Dot_R, const double Cluster_1_R, const double Cluster_2_R, const double Cluster_3_R, const double Cluster_4_R) noexcept;
+    // Set the radius of all clustering elements (radii must be in the range of coordinates and increase after rounding to TCoord)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t ClusteringElems_Set_Radius(const double Dot_R, const double Cluster_1_R, const double Cluster_2_R, const double Cluster_3_R, const double Cluster_4_R) noexcept;
 
     // Reset settings of the additional radius value to default
-    extern "C" __declspec(dllexport) void ClusteringElems_Set_Default_AdditionalRadiusValue_Settings(void) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT void ClusteringElems_Set_Default_AdditionalRadiusValue_Settings(void) noexcept;
 
     // Set settings of the additional radius value
-    extern "C" __declspec(dllexport) void ClusteringElems_Set_AdditionalRadiusValue_Settings(const double Value, const int16_t Usage) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT void ClusteringElems_Set_AdditionalRadiusValue_Settings(const double Value, const int16_t Usage) noexcept;
+
+
+    // Project geographic coordinates (degrees) to Web Mercator (meters) as Clusterizator_Init_Geo_Dots does, invalid coordinates become NaN
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Coords_Geo_To_Web_Mercator(const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, double* Out_X_Arr, double* Out_Y_Arr) noexcept;
+
+    // Convert Web Mercator coordinates (for example, of clustering elements of geographic dots) to geographic ones
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Coords_Web_Mercator_To_Geo(const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, double* Out_Lon_Arr, double* Out_Lat_Arr) noexcept;
 
 
     // Create a new clusterizator. Its code is returned
-    extern "C" __declspec(dllexport) uint32_t Clusterizator_New(void) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint32_t Clusterizator_New(void) noexcept;
 
     // Delete clusterizator
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Delete(const uint32_t ClusterizatorId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Delete(const uint32_t ClusterizatorId) noexcept;
 
     // Delete all clusterizators
-    extern "C" __declspec(dllexport) void Clusterizator_Delete_All(void) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT void Clusterizator_Delete_All(void) noexcept;
 
 
     // Initialize a set of dots
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Init_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Init_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Add a set of dots to the existing dots
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Append_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Initialize a set of dots with geographic coordinates, they are projected to Web Mercator once and the dots are clustered and returned in it
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Init_Geo_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Add a set of dots with geographic coordinates to the existing dots
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Append_Geo_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    /* Add a set of timed dots of the sliding window: Time_Arr holds times of dots in any units (for example, milliseconds), the
+    dot with the same coordinates receives the data and, if it is timed, the later time; dots added otherwise never expire. A new
+    dot joins the nearest existing cluster of the lowest level that can contain it, otherwise it stays free until clusters are
+    created again. Times are not saved in snapshots. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Append_Timed_Dots(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr) noexcept;
+
+    /* Delete timed dots whose latest time is earlier than Min_Time (for the window of the last 15 minutes - the current time minus
+    15 minutes) in O(log n) per dot by the queue of times, the number of deleted dots is returned in Out_ExpiredCount. The last
+    dots take indices of the deleted ones. Clusters are kept: deleted dots are removed from them, clusters left with fewer than
+    two members are deleted and the last clusters of their levels take their indices, the rest are moved to new centers (a cluster
+    moved to the center of another one of its level is absorbed by it). Members of a deleted cluster go to the cluster that
+    contained it; if there is none, they become free and visible, and free dots join the nearest clusters that can contain them.
+    Create clusters again when the exact result is needed. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Expire_Dots(const uint32_t ClusterizatorId, const int64_t Min_Time, uint32_t& Out_ExpiredCount) noexcept;
+
+    // Load dots from the columnar point file (Append: 1 - add to the existing dots, 0 - replace all data), the number of points with NaN or infinite coordinates is returned in Out_RejectedCount
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Load_Point_File(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount) noexcept;
+
+    // Load dots from the CSV file (columns are numbered from 0, Data_Column = -1 - no data; Append: 1 - add to the existing dots, 0 - replace all data)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Load_CSV_File(const uint32_t ClusterizatorId, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept;
+
+    // Load point coordinates from the GeoJSON file, data of the dot is the number of its "coordinates" member (Append: 1 - add to the existing dots, 0 - replace all data)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Load_GeoJSON_File(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept;
 
     // Add single dot
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Add_Dot(const uint32_t ClusterizatorId, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress);
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Add_Dot(const uint32_t ClusterizatorId, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress);
+
+    /* Select dots that take part in clustering (the filter without copying of dots): bit i % 8 of Mask_Arr[i / 8] selects the dot
+    with the index i, dots with indices from DotCount are not selected. Dots out of the selection are skipped by the next creation
+    of clusters and are not visible: they are skipped by Clusterizator_Get_Visible_ClusteringElems, have InCluster 1 in
+    Clusterizator_Get_ClusteringElems and Selected_Arr 0 in the view. New dots are selected, the selection is not saved in
+    snapshots. The number of selected dots is returned in Out_SelectedCount. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Select_Dots(const uint32_t ClusterizatorId, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount) noexcept;
+
+    // Select dots that take part in clustering by their tags: the dot is selected if (Tag & Tag_Mask) == Tag_Value, Tag_Mask = 0 and Tag_Value = 0 select all dots (see Clusterizator_Select_Dots)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Select_Dots_By_Tag(const uint32_t ClusterizatorId, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount) noexcept;
 
     // Create set of clusters_1
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Create_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1) noexcept;
 
     // Create set of clusters_2
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Create_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2) noexcept;
 
     // Create set of clusters_3
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Create_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3) noexcept;
 
     // Create set of clusters_4
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Create_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4) noexcept;
+
+    // Create set of clusters_1 approximately by the grid with cells of the size of the radius in linear time (Merge_Neighbors: 1 - merge clusters of neighboring cells once), error bounds are described at Create_Grid_Clusters_1 in SimpleClustering.h
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Grid_Clusters_1(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_2 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Grid_Clusters_2(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_3 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Grid_Clusters_3(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_4 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Grid_Clusters_4(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors) noexcept;
+
+    /* Create all sets of clusters progressively: clusters are cleared, the coarse preview of clusters_4 is created by the grid from
+    dots in linear time, then it is deleted and clusters_1 ... clusters_4 are created exactly. Callback (may be nullptr) is called
+    after each set, if it stops the refinement at the preview, the preview remains. SingleElem_Mask: bit N - 1 is
+    SingleClusteringElem_To_Cluster_N of the level N. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Create_Clusters_Progressive(const uint32_t ClusterizatorId, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context) noexcept;
 
 
     // Clear all sets of clusters
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Clear_Clusters(const uint32_t ClusterizatorId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Clear_Clusters(const uint32_t ClusterizatorId) noexcept;
 
     // Clear clusterizator
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Clear(const uint32_t ClusterizatorId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Clear(const uint32_t ClusterizatorId) noexcept;
+
+
+    // Save clusterizator to the snapshot file
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Save_Snapshot(const uint32_t ClusterizatorId, const char* FileName) noexcept;
+
+    // Load clusterizator from the snapshot file, all current data is replaced (on failure it remains)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Load_Snapshot(const uint32_t ClusterizatorId, const char* FileName) noexcept;
 
 
     // Get the number of clustering elements of the specified id
-    extern "C" __declspec(dllexport) uint64_t Clusterizator_Get_ClusteringElem_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t Clusterizator_Get_ClusteringElem_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept;
 
     /*** Get the amount of data for clustering element of the specified id ***/
-    template <typename Type> std::size_t Clusterizator_Get_ClusteringElem_Data_Count(const std::map<TCoordKey, Type*>& MapClusteringElem, const double X, const double Y) noexcept
+    template <typename Type> std::size_t Clusterizator_Get_ClusteringElem_Data_Count(const Type* const ClusteringElem) noexcept
     {
-        const auto it = MapClusteringElem.find(TCoordKey(X, Y)); // find clustering element in the set
-
-        if (it != MapClusteringElem.end()) // found
-            return it->second->Get_Count();
+        if (ClusteringElem) // found
+            return ClusteringElem->Get_Count();
         else // not found
             return 0;
     }
 
-    extern "C" __declspec(dllexport) uint64_t Clusterizator_Get_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t Clusterizator_Get_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t Clusterizator_Get_ClusteringElem_Data_Count_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index) noexcept;
     /*************************************************************************/
 
     // Get the amount of data for all clustering elements of the specified id
-    extern "C" __declspec(dllexport) uint64_t Clusterizator_Get_All_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t Clusterizator_Get_All_ClusteringElem_Data_Count(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId) noexcept;
 
     // Get the amount of data for all clustering elements of clusterizator
-    extern "C" __declspec(dllexport) uint64_t Clusterizator_Get_Data_Count(const uint32_t ClusterizatorId) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t Clusterizator_Get_Data_Count(const uint32_t ClusterizatorId) noexcept;
 
 
     /*** Get a set of specified clustering elements ***/
@@ -160,8 +591,8 @@ namespace NS_Clustering
             X_Arr[i]  = ce.first.X;
             Y_Arr[i]  = ce.first.Y;
 
-            if (Address_Of_InCluster_Arr)
-                (*Address_Of_InCluster_Arr)[i] = static_cast<int16_t>(ce.second->InCluster);
+            if (Address_Of_InCluster_Arr) // dots out of the selection are not shown, as the dots in clusters
+                (*Address_Of_InCluster_Arr)[i] = static_cast<int16_t>(ce.second->InCluster || !ce.second->Selected);
 
             if (Address_Of_DataCount_Arr)
                 (*Address_Of_DataCount_Arr)[i] = ce.second->Get_Count();
@@ -173,46 +604,354 @@ namespace NS_Clustering
         }
     }
 
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Get_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept;
     /**************************************************/
 
-    /*** Get data for all dots for specified clustering element ***/
-    template <typename Type> int32_t Clusterizator_Get_ClusteringElem_Data(const std::map<TCoordKey, Type*>& MapClusteringElem, const double X, const double Y, uint64_t* const Data_Arr) noexcept
+    /*** Get indices of specified clustering elements (in the same order as Clusterizator_Get_ClusteringElems) ***/
+    template <typename Type> void Clusterizator_Get_ClusteringElem_Indices(const std::map<TCoordKey, Type*>& MapClusteringElem, uint32_t* const Index_Arr) noexcept
     {
-        const auto it = MapClusteringElem.find(TCoordKey(X, Y)); // find clustering element in the set
+        uint64_t i = 0;
+
+        for (const auto& ce : MapClusteringElem)
+            Index_Arr[i++] = ce.second->Index;
+    }
 
-        if (it != MapClusteringElem.end()) // found
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_Indices(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, uint32_t* Index_Arr) noexcept;
+    /*************************************************************************************************************/
+
+    /*** Get clustering elements of the specified id which are not in any cluster ***/
+    template <typename Type> void Clusterizator_Get_Visible_ClusteringElems(
+        const std::map<TCoordKey, Type*>&  MapClusteringElem,
+        const uint16_t                     ClusteringElemId,
+        const uint64_t                     Capacity,
+        uint16_t* const                    ClusteringElemId_Arr,
+        double* const                      X_Arr,
+        double* const                      Y_Arr,
+        uint64_t* const                    DataCount_Arr,
+        uint32_t* const                    Index_Arr,
+        uint64_t&                          Count) noexcept
+    {
+        for (const auto& ce : MapClusteringElem)
         {
-            uint64_t i = 0;
+            if (ce.second->InCluster || !ce.second->Selected) // dots out of the selection are not shown
+                continue;
 
-            for (const auto data : it->second->Get_Data())
-                Data_Arr[i++] = data;
+            if (Count < Capacity) // elements beyond the capacity are only counted
+            {
+                if (ClusteringElemId_Arr)
+                    ClusteringElemId_Arr[Count] = ClusteringElemId;
 
-            return 0;
+                if (X_Arr)
+                    X_Arr[Count] = ce.first.X;
+
+                if (Y_Arr)
+                    Y_Arr[Count] = ce.first.Y;
+
+                if (DataCount_Arr)
+                    DataCount_Arr[Count] = ce.second->Get_Count();
+
+                if (Index_Arr)
+                    Index_Arr[Count] = ce.second->Index;
+            }
+
+            ++Count;
         }
-        else // not found
-            return 1;
     }
 
-    extern "C" __declspec(dllexport) int32_t Clusterizator_Get_ClusteringElem_Data(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept;
+    /* Get clustering elements of all specified ids which are not in any cluster, in one call. Arrays have Capacity elements (any
+    of them can be nullptr), Out_Count receives the number of such elements; if it is greater than Capacity, nothing is lost:
+    arrays are filled up to Capacity and 1 is returned, so the call can be repeated with arrays of size Out_Count. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_Visible_ClusteringElems(const uint32_t ClusterizatorId, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count) noexcept;
+    /********************************************************************************/
+
+    /* Get read-only arrays of clustering elements of the specified id in the order of their indices without copying. The view is
+    valid until the next change of dots or clusters of the clusterizator (adding, loading, creating, clearing or selecting). */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_View(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, TClusteringElemView& Out_View) noexcept;
+
+    /*** Get data for all dots for specified clustering element ***/
+    /* The sorted union of datasets of the dots is copied, Data_Arr must have the size of the amount of data of the element (the
+    union may be smaller). Datasets of the dots one after another, without merging, are got by pages (see below). */
+    template <typename Type> int32_t Clusterizator_Get_ClusteringElem_Data(const Type* const ClusteringElem, uint64_t* const Data_Arr) noexcept
+    {
+        if (ClusteringElem) // found
+        {
+            try
+            {
+                std::vector<uint64_t> data; // values of all dots
+
+                data.reserve(ClusteringElem->Get_Count());
+
+                // Collect datasets of dots directly, without intermediate sets, then merge them
+                ClusteringElem_For_Each_Data(*ClusteringElem, [&data](const uint64_t* const First, const uint64_t* const Last) { data.insert(data.end(), First, Last); });
+
+                std::sort(data.begin(), data.end());
+                std::copy(data.begin(), std::unique(data.begin(), data.end()), Data_Arr);
+
+                return 0;
+            }
+            catch (...) {}
+        }
+
+        return 1; // not found or there is not enough memory
+    }
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_Data(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_Data_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr) noexcept;
     /**************************************************************/
 
-    /*** Does the specified clustering element contain the specified tag (1 - yes, 0 - no) ***/
-    template <typename Type> int16_t Clusterizator_Is_ClusteringElem_Have_Tag(const std::map<TCoordKey, Type*>& MapClusteringElem, const double X, const double Y, const uint64_t Tag) noexcept
+    /*** Get a page of data for all dots for specified clustering element ***/
+    /* Datasets of the dots are copied one after another without merging (a value of several dots is repeated). No more than PageSize
+    values are copied starting from the position Cursor. The number of copied values is returned in Out_Count, the position of
+    the next page - in Out_NextCursor. The last page contains less than PageSize values. */
+    template <typename Type> int32_t Clusterizator_Get_ClusteringElem_Data_Page(
+        const Type* const  ClusteringElem,
+        const uint64_t     Cursor,
+        const uint64_t     PageSize,
+        uint64_t* const    Data_Arr,
+        uint64_t&          Out_Count,
+        uint64_t&          Out_NextCursor) noexcept
     {
-        const auto it = MapClusteringElem.find(TCoordKey(X, Y)); // find clustering element in the set
+        if (ClusteringElem) // found
+        {
+            uint64_t position  = 0;  // position of the first value of the current dot
+            uint64_t count     = 0;  // number of copied values
+
+            ClusteringElem->For_Each_Dot([&](const TDot* const Dot)
+            {
+                const uint64_t size = Dot->SetData.size();
+
+                if (position + size > Cursor) // dot contains values of the page
+                {
+                    const uint64_t first  = Cursor > position ? Cursor - position : 0;
+                    const uint64_t last   = std::min<uint64_t>(size, first + PageSize - count);
+
+                    std::copy(Dot->SetData.cbegin() + first, Dot->SetData.cbegin() + last, Data_Arr + count);
+                    count += last - first;
+                }
+
+                position += size;
+
+                return count < PageSize; // stop when the page is full
+            });
+
+            Out_Count       = count;
+            Out_NextCursor  = Cursor + count;
 
-        if (it != MapClusteringElem.end()) // found
-            return it->second->Tag == Tag ? 1 : 0;
-        else // not found
             return 0;
+        }
+        else // not found
+            return 1;
     }
 
-    extern "C" __declspec(dllexport) int16_t Clusterizator_Is_ClusteringElem_Have_Tag(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
-    /*****************************************************************************************/
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_Data_Page(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_ClusteringElem_Data_Page_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept;
+    /************************************************************************/
+
+    // Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t Clusterizator_Is_ClusteringElem_Have_Tag(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t Clusterizator_Is_ClusteringElem_Have_Tag_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept;
+
+    // Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t Clusterizator_Is_ClusteringElem_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept;
+
+    // Does each of the specified clustering elements contain the specified tag among all its clustering elements (Result_Arr: 1 - yes, 0 - no)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Is_ClusteringElems_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr) noexcept;
+
+    /* Notify that tags were changed by the addresses of tags, so that the index of tags is rebuilt. Without notifications the
+    checks of tags inside walk the clustering elements. After the first notification they use the index of tags, so each later
+    change of tags by the addresses must also be notified */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Tags_Changed(const uint32_t ClusterizatorId) noexcept;
+
+    /* Get instrumentation counters of the last creation of clusters_1..4 into Out_Stats_Arr of 4 elements. Counters are collected
+    only if the library is built with SIMPLE_CLUSTERING_STATS, otherwise 1 is returned. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_Stats(const uint32_t ClusterizatorId, TStats* Out_Stats_Arr) noexcept;
+
+    /* Get the memory of the clusterizator in bytes: Out_Total_Bytes - all memory, Out_Usage_Arr - memory of dots and clusters_1..4
+    by structures (5 elements, nullptr - only the total is got) */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Get_Memory_Usage(const uint32_t ClusterizatorId, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes) noexcept;
+
+    /* Reclaim the memory of datasets of dots loaded by arrays: their values are kept in shared blocks, and the values of datasets
+    changed later (for example, by Clusterizator_Add_Dot) stay there. The blocks are compacted automatically when they double
+    after loading with append, this call compacts them at once. The number of freed bytes is returned in Out_FreedBytes. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Compact_Dot_Data(const uint32_t ClusterizatorId, uint64_t& Out_FreedBytes) noexcept;
+
+    // Start recording of the timeline of loading, clustering and exporting (a started recording is restarted)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Start_Trace(const uint32_t ClusterizatorId) noexcept;
+
+    /* Stop recording of the timeline and write it to the file in Chrome Trace Event JSON format, which is opened by ui.perfetto.dev
+    or chrome://tracing (FileName - nullptr: the timeline is discarded) */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t Clusterizator_Stop_Trace(const uint32_t ClusterizatorId, const char* FileName) noexcept;
+
+
+    /* Handle API: the functions above for the handle of the clusterizator instead of its id, so calls do not search the
+    clusterizator in the registry. Calls of both APIs may be mixed. */
+
+    // Create a new clusterizator. Its handle is returned (nullptr - failure)
+    extern "C" SIMPLE_CLUSTERING_EXPORT HClusterizator HClusterizator_New(void) noexcept;
+
+    // Get the handle of the clusterizator by its id (nullptr - there is no such clusterizator)
+    extern "C" SIMPLE_CLUSTERING_EXPORT HClusterizator HClusterizator_Find(const uint32_t ClusterizatorId) noexcept;
+
+    // Get the id of the clusterizator by its handle (0 - invalid handle)
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint32_t HClusterizator_Get_Id(HClusterizator Handle) noexcept;
+
+    // Delete clusterizator by its handle, the handle becomes invalid
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Delete(HClusterizator Handle) noexcept;
+
+    // Initialize a set of dots
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Init_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Add a set of dots to the existing dots
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Append_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Initialize a set of dots with geographic coordinates, they are projected to Web Mercator once and the dots are clustered and returned in it
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Init_Geo_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Add a set of dots with geographic coordinates to the existing dots
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Append_Geo_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+    // Add a set of timed dots of the sliding window (see Clusterizator_Append_Timed_Dots)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Append_Timed_Dots(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr) noexcept;
+
+    // Delete timed dots that left the sliding window (see Clusterizator_Expire_Dots)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Expire_Dots(HClusterizator Handle, const int64_t Min_Time, uint32_t& Out_ExpiredCount) noexcept;
+
+    // Load dots from the columnar point file (Append: 1 - add to the existing dots, 0 - replace all data), the number of points with NaN or infinite coordinates is returned in Out_RejectedCount
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Load_Point_File(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount) noexcept;
+
+    // Load dots from the CSV file (columns are numbered from 0, Data_Column = -1 - no data; Append: 1 - add to the existing dots, 0 - replace all data)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Load_CSV_File(HClusterizator Handle, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept;
+
+    // Load point coordinates from the GeoJSON file, data of the dot is the number of its "coordinates" member (Append: 1 - add to the existing dots, 0 - replace all data)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Load_GeoJSON_File(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount) noexcept;
+
+    // Add single dot
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Add_Dot(HClusterizator Handle, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress);
+
+    // Select dots that take part in clustering by the bit mask of their indices (see Clusterizator_Select_Dots)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Select_Dots(HClusterizator Handle, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount) noexcept;
+
+    // Select dots that take part in clustering by their tags (see Clusterizator_Select_Dots_By_Tag)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Select_Dots_By_Tag(HClusterizator Handle, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount) noexcept;
+
+    // Create set of clusters_1
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Clusters_1(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1) noexcept;
+
+    // Create set of clusters_2
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Clusters_2(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2) noexcept;
+
+    // Create set of clusters_3
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Clusters_3(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3) noexcept;
+
+    // Create set of clusters_4
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Clusters_4(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4) noexcept;
+
+    // Create set of clusters_1 approximately by the grid with cells of the size of the radius in linear time (Merge_Neighbors: 1 - merge clusters of neighboring cells once), error bounds are described at Create_Grid_Clusters_1 in SimpleClustering.h
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Grid_Clusters_1(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_2 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Grid_Clusters_2(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_3 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Grid_Clusters_3(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors) noexcept;
+
+    // Create set of clusters_4 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Grid_Clusters_4(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors) noexcept;
+
+    // Create all sets of clusters progressively (see Clusterizator_Create_Clusters_Progressive)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Create_Clusters_Progressive(HClusterizator Handle, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context) noexcept;
+
+    // Clear all sets of clusters
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Clear_Clusters(HClusterizator Handle) noexcept;
+
+    // Clear clusterizator
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Clear(HClusterizator Handle) noexcept;
+
+    // Save clusterizator to the snapshot file
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Save_Snapshot(HClusterizator Handle, const char* FileName) noexcept;
+
+    // Load clusterizator from the snapshot file, all current data is replaced (on failure it remains)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Load_Snapshot(HClusterizator Handle, const char* FileName) noexcept;
+
+    // Get the number of clustering elements of the specified id
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t HClusterizator_Get_ClusteringElem_Count(HClusterizator Handle, const uint16_t ClusteringElemId) noexcept;
+
+    // Get the amount of data for clustering element of the specified id
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t HClusterizator_Get_ClusteringElem_Data_Count(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t HClusterizator_Get_ClusteringElem_Data_Count_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index) noexcept;
+
+    // Get the amount of data for all clustering elements of the specified id
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t HClusterizator_Get_All_ClusteringElem_Data_Count(HClusterizator Handle, const uint16_t ClusteringElemId) noexcept;
+
+    // Get the amount of data for all clustering elements of clusterizator
+    extern "C" SIMPLE_CLUSTERING_EXPORT uint64_t HClusterizator_Get_Data_Count(HClusterizator Handle) noexcept;
+
+    // Get a set of specified clustering elements
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElems(HClusterizator Handle, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr) noexcept;
+
+    // Get indices of specified clustering elements (in the same order as HClusterizator_Get_ClusteringElems)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_Indices(HClusterizator Handle, const uint16_t ClusteringElemId, uint32_t* Index_Arr) noexcept;
+
+    /* Get clustering elements of all specified ids which are not in any cluster, in one call. Arrays have Capacity elements (any
+    of them can be nullptr), Out_Count receives the number of such elements; if it is greater than Capacity, nothing is lost:
+    arrays are filled up to Capacity and 1 is returned, so the call can be repeated with arrays of size Out_Count. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_Visible_ClusteringElems(HClusterizator Handle, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count) noexcept;
+
+    /* Get read-only arrays of clustering elements of the specified id in the order of their indices without copying. The view is
+    valid until the next change of dots or clusters of the clusterizator (adding, loading, creating, clearing or selecting). */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_View(HClusterizator Handle, const uint16_t ClusteringElemId, TClusteringElemView& Out_View) noexcept;
+
+    // Get data for all dots for specified clustering element
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_Data(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_Data_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr) noexcept;
+
+    // Get a page of data for all dots for specified clustering element
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_Data_Page(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_ClusteringElem_Data_Page_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor) noexcept;
+
+    // Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t HClusterizator_Is_ClusteringElem_Have_Tag(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t HClusterizator_Is_ClusteringElem_Have_Tag_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept;
 
     // Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
-    extern "C" __declspec(dllexport) int16_t Clusterizator_Is_ClusteringElem_Have_Tag_Inside(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t HClusterizator_Is_ClusteringElem_Have_Tag_Inside(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag) noexcept;
+
+    extern "C" SIMPLE_CLUSTERING_EXPORT int16_t HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag) noexcept;
+
+    // Does each of the specified clustering elements contain the specified tag among all its clustering elements (Result_Arr: 1 - yes, 0 - no)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Is_ClusteringElems_Have_Tag_Inside(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr) noexcept;
+
+    /* Notify that tags were changed by the addresses of tags, so that the index of tags is rebuilt. Without notifications the
+    checks of tags inside walk the clustering elements. After the first notification they use the index of tags, so each later
+    change of tags by the addresses must also be notified */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Tags_Changed(HClusterizator Handle) noexcept;
+
+    /* Get instrumentation counters of the last creation of clusters_1..4 into Out_Stats_Arr of 4 elements. Counters are collected
+    only if the library is built with SIMPLE_CLUSTERING_STATS, otherwise 1 is returned. */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_Stats(HClusterizator Handle, TStats* Out_Stats_Arr) noexcept;
+
+    /* Get the memory of the clusterizator in bytes: Out_Total_Bytes - all memory, Out_Usage_Arr - memory of dots and clusters_1..4
+    by structures (5 elements, nullptr - only the total is got) */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Get_Memory_Usage(HClusterizator Handle, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes) noexcept;
+
+    // Reclaim the memory of datasets of dots loaded by arrays (see Clusterizator_Compact_Dot_Data)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Compact_Dot_Data(HClusterizator Handle, uint64_t& Out_FreedBytes) noexcept;
+
+    // Start recording of the timeline of loading, clustering and exporting (a started recording is restarted)
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Start_Trace(HClusterizator Handle) noexcept;
+
+    /* Stop recording of the timeline and write it to the file in Chrome Trace Event JSON format, which is opened by ui.perfetto.dev
+    or chrome://tracing (FileName - nullptr: the timeline is discarded) */
+    extern "C" SIMPLE_CLUSTERING_EXPORT int32_t HClusterizator_Stop_Trace(HClusterizator Handle, const char* FileName) noexcept;
 }
 
 #endif
@@ -12,23 +12,52 @@
 
 #include "SimpleClusteringLibUser.h"
 
+#if !defined(_WIN32)
+  namespace
+  {
+      // Get the address of the exported symbol of the shared object in the same way as from DLL
+      inline void* GetProcAddress(void* const HandleDll, const char* const Name) noexcept
+      {
+          return dlsym(HandleDll, Name);
+      }
+  }
+#endif
+
 /*** TClustering ************************************************************************************/
 NS_Clustering::TClustering::~TClustering(void) noexcept
 {
     if (HandleDll)
-        try { FreeLibrary(HandleDll); } catch (...) {}
+    {
+        #if defined(_WIN32)
+          try { FreeLibrary(HandleDll); } catch (...) {}
+        #else
+          dlclose(HandleDll);
+        #endif
+    }
 }
 
 // Load DLL
-bool NS_Clustering::TClustering::LoadDll(const std::wstring& DllDir) noexcept
+#if defined(_WIN32)
+  bool NS_Clustering::TClustering::LoadDll(const std::wstring& DllDir, const TCoordType CoordType) noexcept
+#else
+  bool NS_Clustering::TClustering::LoadDll(const std::string& DllDir, const TCoordType CoordType) noexcept
+#endif
 {
     try
     {
         // Load DLL
+        #if defined(_WIN32)
+          const wchar_t* const suffix = CoordType == COORD_FLOAT ? L"_Float" : CoordType == COORD_INT ? L"_Int" : L"";
+        #else
+          const char* const suffix = CoordType == COORD_FLOAT ? "_Float" : CoordType == COORD_INT ? "_Int" : "";
+        #endif
+
         #if defined(_WIN64)
-          HandleDll = LoadLibraryW((DllDir + L"SimpleClustering_x64.dll").c_str());
+          HandleDll = LoadLibraryW((DllDir + L"SimpleClustering" + suffix + L"_x64.dll").c_str());
+        #elif defined(_WIN32)
+          HandleDll = LoadLibraryW((DllDir + L"SimpleClustering" + suffix + L"_x32.dll").c_str());
         #else
-          HandleDll = LoadLibraryW((DllDir + L"SimpleClustering_x32.dll").c_str());
+          HandleDll = dlopen((DllDir + "libSimpleClustering" + suffix + ".so").c_str(), RTLD_NOW | RTLD_LOCAL);
         #endif
 
         if (HandleDll)
@@ -54,30 +83,121 @@ bool NS_Clustering::TClustering::LoadDll(const std::wstring& DllDir) noexcept
             ClusteringElems_Set_Default_AdditionalRadiusValue_Settings  = reinterpret_cast<_ClusteringElems_Set_Default_AdditionalRadiusValue_Settings>(GetProcAddress(HandleDll, "ClusteringElems_Set_Default_AdditionalRadiusValue_Settings"));
             ClusteringElems_Set_AdditionalRadiusValue_Settings          = reinterpret_cast<_ClusteringElems_Set_AdditionalRadiusValue_Settings>(GetProcAddress(HandleDll, "ClusteringElems_Set_AdditionalRadiusValue_Settings"));
 
+            Coords_Geo_To_Web_Mercator  = reinterpret_cast<_Coords_Geo_To_Web_Mercator>(GetProcAddress(HandleDll, "Coords_Geo_To_Web_Mercator"));
+            Coords_Web_Mercator_To_Geo  = reinterpret_cast<_Coords_Web_Mercator_To_Geo>(GetProcAddress(HandleDll, "Coords_Web_Mercator_To_Geo"));
+
             Clusterizator_New         = reinterpret_cast<_Clusterizator_New>(GetProcAddress(HandleDll, "Clusterizator_New"));
             Clusterizator_Delete      = reinterpret_cast<_Clusterizator_Delete>(GetProcAddress(HandleDll, "Clusterizator_Delete"));
             Clusterizator_Delete_All  = reinterpret_cast<_Clusterizator_Delete_All>(GetProcAddress(HandleDll, "Clusterizator_Delete_All"));
 
-            Clusterizator_Init_Dots          = reinterpret_cast<_Clusterizator_Init_Dots>(GetProcAddress(HandleDll, "Clusterizator_Init_Dots"));
-            Clusterizator_Add_Dot            = reinterpret_cast<_Clusterizator_Add_Dot>(GetProcAddress(HandleDll, "Clusterizator_Add_Dot"));
-            Clusterizator_Create_Clusters_1  = reinterpret_cast<_Clusterizator_Create_Clusters_1>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_1"));
-            Clusterizator_Create_Clusters_2  = reinterpret_cast<_Clusterizator_Create_Clusters_2>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_2"));
-            Clusterizator_Create_Clusters_3  = reinterpret_cast<_Clusterizator_Create_Clusters_3>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_3"));
-            Clusterizator_Create_Clusters_4  = reinterpret_cast<_Clusterizator_Create_Clusters_4>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_4"));
+            Clusterizator_Init_Dots                    = reinterpret_cast<_Clusterizator_Init_Dots>(GetProcAddress(HandleDll, "Clusterizator_Init_Dots"));
+            Clusterizator_Append_Dots                  = reinterpret_cast<_Clusterizator_Append_Dots>(GetProcAddress(HandleDll, "Clusterizator_Append_Dots"));
+            Clusterizator_Init_Geo_Dots                = reinterpret_cast<_Clusterizator_Init_Geo_Dots>(GetProcAddress(HandleDll, "Clusterizator_Init_Geo_Dots"));
+            Clusterizator_Append_Geo_Dots              = reinterpret_cast<_Clusterizator_Append_Geo_Dots>(GetProcAddress(HandleDll, "Clusterizator_Append_Geo_Dots"));
+            Clusterizator_Append_Timed_Dots            = reinterpret_cast<_Clusterizator_Append_Timed_Dots>(GetProcAddress(HandleDll, "Clusterizator_Append_Timed_Dots"));
+            Clusterizator_Expire_Dots                  = reinterpret_cast<_Clusterizator_Expire_Dots>(GetProcAddress(HandleDll, "Clusterizator_Expire_Dots"));
+            Clusterizator_Load_Point_File              = reinterpret_cast<_Clusterizator_Load_Point_File>(GetProcAddress(HandleDll, "Clusterizator_Load_Point_File"));
+            Clusterizator_Load_CSV_File                = reinterpret_cast<_Clusterizator_Load_CSV_File>(GetProcAddress(HandleDll, "Clusterizator_Load_CSV_File"));
+            Clusterizator_Load_GeoJSON_File            = reinterpret_cast<_Clusterizator_Load_GeoJSON_File>(GetProcAddress(HandleDll, "Clusterizator_Load_GeoJSON_File"));
+            Clusterizator_Add_Dot                      = reinterpret_cast<_Clusterizator_Add_Dot>(GetProcAddress(HandleDll, "Clusterizator_Add_Dot"));
+            Clusterizator_Select_Dots                  = reinterpret_cast<_Clusterizator_Select_Dots>(GetProcAddress(HandleDll, "Clusterizator_Select_Dots"));
+            Clusterizator_Select_Dots_By_Tag           = reinterpret_cast<_Clusterizator_Select_Dots_By_Tag>(GetProcAddress(HandleDll, "Clusterizator_Select_Dots_By_Tag"));
+            Clusterizator_Create_Clusters_1            = reinterpret_cast<_Clusterizator_Create_Clusters_1>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_1"));
+            Clusterizator_Create_Clusters_2            = reinterpret_cast<_Clusterizator_Create_Clusters_2>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_2"));
+            Clusterizator_Create_Clusters_3            = reinterpret_cast<_Clusterizator_Create_Clusters_3>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_3"));
+            Clusterizator_Create_Clusters_4            = reinterpret_cast<_Clusterizator_Create_Clusters_4>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_4"));
+            Clusterizator_Create_Grid_Clusters_1       = reinterpret_cast<_Clusterizator_Create_Grid_Clusters_1>(GetProcAddress(HandleDll, "Clusterizator_Create_Grid_Clusters_1"));
+            Clusterizator_Create_Grid_Clusters_2       = reinterpret_cast<_Clusterizator_Create_Grid_Clusters_2>(GetProcAddress(HandleDll, "Clusterizator_Create_Grid_Clusters_2"));
+            Clusterizator_Create_Grid_Clusters_3       = reinterpret_cast<_Clusterizator_Create_Grid_Clusters_3>(GetProcAddress(HandleDll, "Clusterizator_Create_Grid_Clusters_3"));
+            Clusterizator_Create_Grid_Clusters_4       = reinterpret_cast<_Clusterizator_Create_Grid_Clusters_4>(GetProcAddress(HandleDll, "Clusterizator_Create_Grid_Clusters_4"));
+            Clusterizator_Create_Clusters_Progressive  = reinterpret_cast<_Clusterizator_Create_Clusters_Progressive>(GetProcAddress(HandleDll, "Clusterizator_Create_Clusters_Progressive"));
 
             Clusterizator_Clear_Clusters  = reinterpret_cast<_Clusterizator_Clear_Clusters>(GetProcAddress(HandleDll, "Clusterizator_Clear_Clusters"));
             Clusterizator_Clear           = reinterpret_cast<_Clusterizator_Clear>(GetProcAddress(HandleDll, "Clusterizator_Clear"));
 
-            Clusterizator_Get_ClusteringElem_Count           = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Count"));
-            Clusterizator_Get_ClusteringElem_Data_Count      = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_Count"));
-            Clusterizator_Get_All_ClusteringElem_Data_Count  = reinterpret_cast<_Clusterizator_Get_All_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_All_ClusteringElem_Data_Count"));
-            Clusterizator_Get_Data_Count                     = reinterpret_cast<_Clusterizator_Get_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_Data_Count"));
+            Clusterizator_Save_Snapshot  = reinterpret_cast<_Clusterizator_Save_Snapshot>(GetProcAddress(HandleDll, "Clusterizator_Save_Snapshot"));
+            Clusterizator_Load_Snapshot  = reinterpret_cast<_Clusterizator_Load_Snapshot>(GetProcAddress(HandleDll, "Clusterizator_Load_Snapshot"));
+
+            Clusterizator_Get_ClusteringElem_Count                = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Count"));
+            Clusterizator_Get_ClusteringElem_Data_Count           = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_Count"));
+            Clusterizator_Get_ClusteringElem_Data_Count_By_Index  = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_Count_By_Index>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_Count_By_Index"));
+            Clusterizator_Get_All_ClusteringElem_Data_Count       = reinterpret_cast<_Clusterizator_Get_All_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_All_ClusteringElem_Data_Count"));
+            Clusterizator_Get_Data_Count                          = reinterpret_cast<_Clusterizator_Get_Data_Count>(GetProcAddress(HandleDll, "Clusterizator_Get_Data_Count"));
+
+            Clusterizator_Get_ClusteringElems                    = reinterpret_cast<_Clusterizator_Get_ClusteringElems>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElems"));
+            Clusterizator_Get_ClusteringElem_Indices             = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Indices>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Indices"));
+            Clusterizator_Get_Visible_ClusteringElems            = reinterpret_cast<_Clusterizator_Get_Visible_ClusteringElems>(GetProcAddress(HandleDll, "Clusterizator_Get_Visible_ClusteringElems"));
+            Clusterizator_Get_ClusteringElem_View                = reinterpret_cast<_Clusterizator_Get_ClusteringElem_View>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_View"));
+            Clusterizator_Get_ClusteringElem_Data                = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data"));
+            Clusterizator_Get_ClusteringElem_Data_By_Index       = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_By_Index>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_By_Index"));
+            Clusterizator_Get_ClusteringElem_Data_Page           = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_Page>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_Page"));
+            Clusterizator_Get_ClusteringElem_Data_Page_By_Index  = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data_Page_By_Index>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data_Page_By_Index"));
 
-            Clusterizator_Get_ClusteringElems      = reinterpret_cast<_Clusterizator_Get_ClusteringElems>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElems"));
-            Clusterizator_Get_ClusteringElem_Data  = reinterpret_cast<_Clusterizator_Get_ClusteringElem_Data>(GetProcAddress(HandleDll, "Clusterizator_Get_ClusteringElem_Data"));
+            Clusterizator_Is_ClusteringElem_Have_Tag                  = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag"));
+            Clusterizator_Is_ClusteringElem_Have_Tag_By_Index         = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag_By_Index>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag_By_Index"));
+            Clusterizator_Is_ClusteringElem_Have_Tag_Inside           = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag_Inside>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag_Inside"));
+            Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index  = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index"));
+            Clusterizator_Is_ClusteringElems_Have_Tag_Inside          = reinterpret_cast<_Clusterizator_Is_ClusteringElems_Have_Tag_Inside>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElems_Have_Tag_Inside"));
+            Clusterizator_Tags_Changed                                = reinterpret_cast<_Clusterizator_Tags_Changed>(GetProcAddress(HandleDll, "Clusterizator_Tags_Changed"));
+            Clusterizator_Get_Stats                                   = reinterpret_cast<_Clusterizator_Get_Stats>(GetProcAddress(HandleDll, "Clusterizator_Get_Stats"));
+            Clusterizator_Start_Trace                                 = reinterpret_cast<_Clusterizator_Start_Trace>(GetProcAddress(HandleDll, "Clusterizator_Start_Trace"));
+            Clusterizator_Stop_Trace                                  = reinterpret_cast<_Clusterizator_Stop_Trace>(GetProcAddress(HandleDll, "Clusterizator_Stop_Trace"));
+            Clusterizator_Get_Memory_Usage                            = reinterpret_cast<_Clusterizator_Get_Memory_Usage>(GetProcAddress(HandleDll, "Clusterizator_Get_Memory_Usage"));
+            Clusterizator_Compact_Dot_Data                            = reinterpret_cast<_Clusterizator_Compact_Dot_Data>(GetProcAddress(HandleDll, "Clusterizator_Compact_Dot_Data"));
 
-            Clusterizator_Is_ClusteringElem_Have_Tag         = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag"));
-            Clusterizator_Is_ClusteringElem_Have_Tag_Inside  = reinterpret_cast<_Clusterizator_Is_ClusteringElem_Have_Tag_Inside>(GetProcAddress(HandleDll, "Clusterizator_Is_ClusteringElem_Have_Tag_Inside"));
+            HClusterizator_New                                         = reinterpret_cast<_HClusterizator_New>(GetProcAddress(HandleDll, "HClusterizator_New"));
+            HClusterizator_Find                                        = reinterpret_cast<_HClusterizator_Find>(GetProcAddress(HandleDll, "HClusterizator_Find"));
+            HClusterizator_Get_Id                                      = reinterpret_cast<_HClusterizator_Get_Id>(GetProcAddress(HandleDll, "HClusterizator_Get_Id"));
+            HClusterizator_Delete                                      = reinterpret_cast<_HClusterizator_Delete>(GetProcAddress(HandleDll, "HClusterizator_Delete"));
+            HClusterizator_Init_Dots                                   = reinterpret_cast<_HClusterizator_Init_Dots>(GetProcAddress(HandleDll, "HClusterizator_Init_Dots"));
+            HClusterizator_Append_Dots                                 = reinterpret_cast<_HClusterizator_Append_Dots>(GetProcAddress(HandleDll, "HClusterizator_Append_Dots"));
+            HClusterizator_Init_Geo_Dots                               = reinterpret_cast<_HClusterizator_Init_Geo_Dots>(GetProcAddress(HandleDll, "HClusterizator_Init_Geo_Dots"));
+            HClusterizator_Append_Geo_Dots                             = reinterpret_cast<_HClusterizator_Append_Geo_Dots>(GetProcAddress(HandleDll, "HClusterizator_Append_Geo_Dots"));
+            HClusterizator_Append_Timed_Dots                           = reinterpret_cast<_HClusterizator_Append_Timed_Dots>(GetProcAddress(HandleDll, "HClusterizator_Append_Timed_Dots"));
+            HClusterizator_Expire_Dots                                 = reinterpret_cast<_HClusterizator_Expire_Dots>(GetProcAddress(HandleDll, "HClusterizator_Expire_Dots"));
+            HClusterizator_Load_Point_File                             = reinterpret_cast<_HClusterizator_Load_Point_File>(GetProcAddress(HandleDll, "HClusterizator_Load_Point_File"));
+            HClusterizator_Load_CSV_File                               = reinterpret_cast<_HClusterizator_Load_CSV_File>(GetProcAddress(HandleDll, "HClusterizator_Load_CSV_File"));
+            HClusterizator_Load_GeoJSON_File                           = reinterpret_cast<_HClusterizator_Load_GeoJSON_File>(GetProcAddress(HandleDll, "HClusterizator_Load_GeoJSON_File"));
+            HClusterizator_Add_Dot                                     = reinterpret_cast<_HClusterizator_Add_Dot>(GetProcAddress(HandleDll, "HClusterizator_Add_Dot"));
+            HClusterizator_Select_Dots                                 = reinterpret_cast<_HClusterizator_Select_Dots>(GetProcAddress(HandleDll, "HClusterizator_Select_Dots"));
+            HClusterizator_Select_Dots_By_Tag                          = reinterpret_cast<_HClusterizator_Select_Dots_By_Tag>(GetProcAddress(HandleDll, "HClusterizator_Select_Dots_By_Tag"));
+            HClusterizator_Create_Clusters_1                           = reinterpret_cast<_HClusterizator_Create_Clusters_1>(GetProcAddress(HandleDll, "HClusterizator_Create_Clusters_1"));
+            HClusterizator_Create_Clusters_2                           = reinterpret_cast<_HClusterizator_Create_Clusters_2>(GetProcAddress(HandleDll, "HClusterizator_Create_Clusters_2"));
+            HClusterizator_Create_Clusters_3                           = reinterpret_cast<_HClusterizator_Create_Clusters_3>(GetProcAddress(HandleDll, "HClusterizator_Create_Clusters_3"));
+            HClusterizator_Create_Clusters_4                           = reinterpret_cast<_HClusterizator_Create_Clusters_4>(GetProcAddress(HandleDll, "HClusterizator_Create_Clusters_4"));
+            HClusterizator_Create_Grid_Clusters_1                      = reinterpret_cast<_HClusterizator_Create_Grid_Clusters_1>(GetProcAddress(HandleDll, "HClusterizator_Create_Grid_Clusters_1"));
+            HClusterizator_Create_Grid_Clusters_2                      = reinterpret_cast<_HClusterizator_Create_Grid_Clusters_2>(GetProcAddress(HandleDll, "HClusterizator_Create_Grid_Clusters_2"));
+            HClusterizator_Create_Grid_Clusters_3                      = reinterpret_cast<_HClusterizator_Create_Grid_Clusters_3>(GetProcAddress(HandleDll, "HClusterizator_Create_Grid_Clusters_3"));
+            HClusterizator_Create_Grid_Clusters_4                      = reinterpret_cast<_HClusterizator_Create_Grid_Clusters_4>(GetProcAddress(HandleDll, "HClusterizator_Create_Grid_Clusters_4"));
+            HClusterizator_Create_Clusters_Progressive                 = reinterpret_cast<_HClusterizator_Create_Clusters_Progressive>(GetProcAddress(HandleDll, "HClusterizator_Create_Clusters_Progressive"));
+            HClusterizator_Clear_Clusters                              = reinterpret_cast<_HClusterizator_Clear_Clusters>(GetProcAddress(HandleDll, "HClusterizator_Clear_Clusters"));
+            HClusterizator_Clear                                       = reinterpret_cast<_HClusterizator_Clear>(GetProcAddress(HandleDll, "HClusterizator_Clear"));
+            HClusterizator_Save_Snapshot                               = reinterpret_cast<_HClusterizator_Save_Snapshot>(GetProcAddress(HandleDll, "HClusterizator_Save_Snapshot"));
+            HClusterizator_Load_Snapshot                               = reinterpret_cast<_HClusterizator_Load_Snapshot>(GetProcAddress(HandleDll, "HClusterizator_Load_Snapshot"));
+            HClusterizator_Get_ClusteringElem_Count                    = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Count>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Count"));
+            HClusterizator_Get_ClusteringElem_Data_Count               = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data_Count"));
+            HClusterizator_Get_ClusteringElem_Data_Count_By_Index      = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data_Count_By_Index>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data_Count_By_Index"));
+            HClusterizator_Get_All_ClusteringElem_Data_Count           = reinterpret_cast<_HClusterizator_Get_All_ClusteringElem_Data_Count>(GetProcAddress(HandleDll, "HClusterizator_Get_All_ClusteringElem_Data_Count"));
+            HClusterizator_Get_Data_Count                              = reinterpret_cast<_HClusterizator_Get_Data_Count>(GetProcAddress(HandleDll, "HClusterizator_Get_Data_Count"));
+            HClusterizator_Get_ClusteringElems                         = reinterpret_cast<_HClusterizator_Get_ClusteringElems>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElems"));
+            HClusterizator_Get_ClusteringElem_Indices                  = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Indices>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Indices"));
+            HClusterizator_Get_Visible_ClusteringElems                 = reinterpret_cast<_HClusterizator_Get_Visible_ClusteringElems>(GetProcAddress(HandleDll, "HClusterizator_Get_Visible_ClusteringElems"));
+            HClusterizator_Get_ClusteringElem_View                     = reinterpret_cast<_HClusterizator_Get_ClusteringElem_View>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_View"));
+            HClusterizator_Get_ClusteringElem_Data                     = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data"));
+            HClusterizator_Get_ClusteringElem_Data_By_Index            = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data_By_Index>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data_By_Index"));
+            HClusterizator_Get_ClusteringElem_Data_Page                = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data_Page>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data_Page"));
+            HClusterizator_Get_ClusteringElem_Data_Page_By_Index       = reinterpret_cast<_HClusterizator_Get_ClusteringElem_Data_Page_By_Index>(GetProcAddress(HandleDll, "HClusterizator_Get_ClusteringElem_Data_Page_By_Index"));
+            HClusterizator_Is_ClusteringElem_Have_Tag                  = reinterpret_cast<_HClusterizator_Is_ClusteringElem_Have_Tag>(GetProcAddress(HandleDll, "HClusterizator_Is_ClusteringElem_Have_Tag"));
+            HClusterizator_Is_ClusteringElem_Have_Tag_By_Index         = reinterpret_cast<_HClusterizator_Is_ClusteringElem_Have_Tag_By_Index>(GetProcAddress(HandleDll, "HClusterizator_Is_ClusteringElem_Have_Tag_By_Index"));
+            HClusterizator_Is_ClusteringElem_Have_Tag_Inside           = reinterpret_cast<_HClusterizator_Is_ClusteringElem_Have_Tag_Inside>(GetProcAddress(HandleDll, "HClusterizator_Is_ClusteringElem_Have_Tag_Inside"));
+            HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index  = reinterpret_cast<_HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index>(GetProcAddress(HandleDll, "HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index"));
+            HClusterizator_Is_ClusteringElems_Have_Tag_Inside          = reinterpret_cast<_HClusterizator_Is_ClusteringElems_Have_Tag_Inside>(GetProcAddress(HandleDll, "HClusterizator_Is_ClusteringElems_Have_Tag_Inside"));
+            HClusterizator_Tags_Changed                                = reinterpret_cast<_HClusterizator_Tags_Changed>(GetProcAddress(HandleDll, "HClusterizator_Tags_Changed"));
+            HClusterizator_Get_Stats                                   = reinterpret_cast<_HClusterizator_Get_Stats>(GetProcAddress(HandleDll, "HClusterizator_Get_Stats"));
+            HClusterizator_Get_Memory_Usage                            = reinterpret_cast<_HClusterizator_Get_Memory_Usage>(GetProcAddress(HandleDll, "HClusterizator_Get_Memory_Usage"));
+            HClusterizator_Compact_Dot_Data                            = reinterpret_cast<_HClusterizator_Compact_Dot_Data>(GetProcAddress(HandleDll, "HClusterizator_Compact_Dot_Data"));
+            HClusterizator_Start_Trace                                 = reinterpret_cast<_HClusterizator_Start_Trace>(GetProcAddress(HandleDll, "HClusterizator_Start_Trace"));
+            HClusterizator_Stop_Trace                                  = reinterpret_cast<_HClusterizator_Stop_Trace>(GetProcAddress(HandleDll, "HClusterizator_Stop_Trace"));
 
             if (ID_DOT &&
                 ID_CLUSTER_1 &&
@@ -95,25 +215,113 @@ bool NS_Clustering::TClustering::LoadDll(const std::wstring& DllDir) noexcept
                 ClusteringElems_Set_Radius &&
                 ClusteringElems_Set_Default_AdditionalRadiusValue_Settings &&
                 ClusteringElems_Set_AdditionalRadiusValue_Settings &&
+                Coords_Geo_To_Web_Mercator &&
+                Coords_Web_Mercator_To_Geo &&
                 Clusterizator_New &&
                 Clusterizator_Delete &&
                 Clusterizator_Delete_All &&
                 Clusterizator_Init_Dots &&
+                Clusterizator_Append_Dots &&
+                Clusterizator_Init_Geo_Dots &&
+                Clusterizator_Append_Geo_Dots &&
+                Clusterizator_Append_Timed_Dots &&
+                Clusterizator_Expire_Dots &&
+                Clusterizator_Load_Point_File &&
+                Clusterizator_Load_CSV_File &&
+                Clusterizator_Load_GeoJSON_File &&
                 Clusterizator_Add_Dot &&
+                Clusterizator_Select_Dots &&
+                Clusterizator_Select_Dots_By_Tag &&
                 Clusterizator_Create_Clusters_1 &&
                 Clusterizator_Create_Clusters_2 &&
                 Clusterizator_Create_Clusters_3 &&
                 Clusterizator_Create_Clusters_4 &&
+                Clusterizator_Create_Grid_Clusters_1 &&
+                Clusterizator_Create_Grid_Clusters_2 &&
+                Clusterizator_Create_Grid_Clusters_3 &&
+                Clusterizator_Create_Grid_Clusters_4 &&
+                Clusterizator_Create_Clusters_Progressive &&
                 Clusterizator_Clear_Clusters &&
                 Clusterizator_Clear &&
+                Clusterizator_Save_Snapshot &&
+                Clusterizator_Load_Snapshot &&
                 Clusterizator_Get_ClusteringElem_Count &&
                 Clusterizator_Get_ClusteringElem_Data_Count &&
+                Clusterizator_Get_ClusteringElem_Data_Count_By_Index &&
                 Clusterizator_Get_All_ClusteringElem_Data_Count &&
                 Clusterizator_Get_Data_Count &&
                 Clusterizator_Get_ClusteringElems &&
+                Clusterizator_Get_ClusteringElem_Indices &&
+                Clusterizator_Get_Visible_ClusteringElems &&
+                Clusterizator_Get_ClusteringElem_View &&
                 Clusterizator_Get_ClusteringElem_Data &&
+                Clusterizator_Get_ClusteringElem_Data_By_Index &&
+                Clusterizator_Get_ClusteringElem_Data_Page &&
+                Clusterizator_Get_ClusteringElem_Data_Page_By_Index &&
                 Clusterizator_Is_ClusteringElem_Have_Tag &&
-                Clusterizator_Is_ClusteringElem_Have_Tag_Inside)
+                Clusterizator_Is_ClusteringElem_Have_Tag_By_Index &&
+                Clusterizator_Is_ClusteringElem_Have_Tag_Inside &&
+                Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index &&
+                Clusterizator_Is_ClusteringElems_Have_Tag_Inside &&
+                Clusterizator_Tags_Changed &&
+                Clusterizator_Get_Stats &&
+                Clusterizator_Start_Trace &&
+                Clusterizator_Stop_Trace &&
+                Clusterizator_Get_Memory_Usage &&
+                Clusterizator_Compact_Dot_Data &&
+                HClusterizator_New &&
+                HClusterizator_Find &&
+                HClusterizator_Get_Id &&
+                HClusterizator_Delete &&
+                HClusterizator_Init_Dots &&
+                HClusterizator_Append_Dots &&
+                HClusterizator_Init_Geo_Dots &&
+                HClusterizator_Append_Geo_Dots &&
+                HClusterizator_Append_Timed_Dots &&
+                HClusterizator_Expire_Dots &&
+                HClusterizator_Load_Point_File &&
+                HClusterizator_Load_CSV_File &&
+                HClusterizator_Load_GeoJSON_File &&
+                HClusterizator_Add_Dot &&
+                HClusterizator_Select_Dots &&
+                HClusterizator_Select_Dots_By_Tag &&
+                HClusterizator_Create_Clusters_1 &&
+                HClusterizator_Create_Clusters_2 &&
+                HClusterizator_Create_Clusters_3 &&
+                HClusterizator_Create_Clusters_4 &&
+                HClusterizator_Create_Grid_Clusters_1 &&
+                HClusterizator_Create_Grid_Clusters_2 &&
+                HClusterizator_Create_Grid_Clusters_3 &&
+                HClusterizator_Create_Grid_Clusters_4 &&
+                HClusterizator_Create_Clusters_Progressive &&
+                HClusterizator_Clear_Clusters &&
+                HClusterizator_Clear &&
+                HClusterizator_Save_Snapshot &&
+                HClusterizator_Load_Snapshot &&
+                HClusterizator_Get_ClusteringElem_Count &&
+                HClusterizator_Get_ClusteringElem_Data_Count &&
+                HClusterizator_Get_ClusteringElem_Data_Count_By_Index &&
+                HClusterizator_Get_All_ClusteringElem_Data_Count &&
+                HClusterizator_Get_Data_Count &&
+                HClusterizator_Get_ClusteringElems &&
+                HClusterizator_Get_ClusteringElem_Indices &&
+                HClusterizator_Get_Visible_ClusteringElems &&
+                HClusterizator_Get_ClusteringElem_View &&
+                HClusterizator_Get_ClusteringElem_Data &&
+                HClusterizator_Get_ClusteringElem_Data_By_Index &&
+                HClusterizator_Get_ClusteringElem_Data_Page &&
+                HClusterizator_Get_ClusteringElem_Data_Page_By_Index &&
+                HClusterizator_Is_ClusteringElem_Have_Tag &&
+                HClusterizator_Is_ClusteringElem_Have_Tag_By_Index &&
+                HClusterizator_Is_ClusteringElem_Have_Tag_Inside &&
+                HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index &&
+                HClusterizator_Is_ClusteringElems_Have_Tag_Inside &&
+                HClusterizator_Tags_Changed &&
+                HClusterizator_Get_Stats &&
+                HClusterizator_Get_Memory_Usage &&
+                HClusterizator_Compact_Dot_Data &&
+                HClusterizator_Start_Trace &&
+                HClusterizator_Stop_Trace)
             {
                 return true;
             }
@@ -17,10 +17,62 @@
 
 #include <cstdint>
 
-#include <windows.h>
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <dlfcn.h>
+#endif
 
 namespace NS_Clustering
 {
+    enum TCoordType // type of coordinates the library is built with
+    {
+        COORD_DOUBLE,  // SimpleClustering
+        COORD_FLOAT,   // SimpleClustering_Float
+        COORD_INT      // SimpleClustering_Int, coordinates are rounded to integers
+    };
+
+    struct TClusteringElemView // read-only arrays of clustering elements of one id in the order of their indices (as in the library)
+    {
+        uint32_t         Count;             // number of elements
+        const double*    X_Arr;             // X coordinates of centers
+        const double*    Y_Arr;             // Y coordinates of centers
+        const uint64_t*  DataCount_Arr;     // amount of data
+        const uint64_t*  DotCount_Arr;      // number of dots
+        const uint16_t*  Parent_Id_Arr;     // id of the cluster that contains the element (0xFFFF - not in any cluster)
+        const uint32_t*  Parent_Index_Arr;  // index of the cluster that contains the element (0xFFFFFFFF - not in any cluster)
+        const uint8_t*   Selected_Arr;      // whether the element takes part in clustering (0 - the dot is out of the selection and is not shown)
+    };
+
+    struct TStats // instrumentation counters of a phase of clustering (as in the library)
+    {
+        uint64_t  Coord_In_Circle_Count;  // evaluations of Coord_In_Circle
+        uint64_t  Merge_Pass_Count;       // passes of merging loops (while something is merged)
+        uint64_t  Merge_Count;            // merges of clustering elements into clusters and of clusters with each other
+        uint64_t  Set_Center_Count;       // calculations of centers of clusters
+        uint64_t  Allocation_Count;       // created clustering elements
+        uint64_t  Nanoseconds;            // wall time of the phase
+    };
+
+    struct TMemoryUsage // memory of clustering elements of one id in bytes (as in the library)
+    {
+        uint64_t  Count;         // number of elements
+        uint64_t  Elem_Bytes;    // objects of elements
+        uint64_t  Map_Bytes;     // nodes of the set of elements
+        uint64_t  Index_Bytes;   // dense array of elements by their indices
+        uint64_t  Member_Bytes;  // dots: own buffers of datasets and blocks of datasets loaded by arrays, clusters: maps of members
+        uint64_t  View_Bytes;    // arrays of the view
+        uint64_t  Total_Bytes;   // all memory of elements
+    };
+
+    // Handle of the clusterizator for functions HClusterizator_* (opaque)
+    struct TClusterizatorHandle;
+
+    using HClusterizator = TClusterizatorHandle*;
+
+    // Function that is called by Clusterizator_Create_Clusters_Progressive when a set of clusters is ready (as in the library)
+    using TLevelReadyCallback = int32_t (*)(void* Context, const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const int16_t Final);
+
     class TClustering
     {
     private:
@@ -37,6 +89,13 @@ namespace NS_Clustering
         using _ClusteringElems_Set_AdditionalRadiusValue_Settings = void (*)(const double Value, const int16_t Usage);
 
 
+        // Project geographic coordinates (degrees) to Web Mercator (meters) as Clusterizator_Init_Geo_Dots does, invalid coordinates become NaN
+        using _Coords_Geo_To_Web_Mercator = int32_t (*)(const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, double* Out_X_Arr, double* Out_Y_Arr);
+
+        // Convert Web Mercator coordinates (for example, of clustering elements of geographic dots) to geographic ones
+        using _Coords_Web_Mercator_To_Geo = int32_t (*)(const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, double* Out_Lon_Arr, double* Out_Lat_Arr);
+
+
         // Create a new clusterizator. Its code is returned
         using _Clusterizator_New = uint32_t (*)(void);
 
@@ -50,9 +109,39 @@ namespace NS_Clustering
         // Initialize a set of dots
         using _Clusterizator_Init_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
 
+        // Add a set of dots to the existing dots
+        using _Clusterizator_Append_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Initialize a set of dots with geographic coordinates, they are projected to Web Mercator once and the dots are clustered and returned in it
+        using _Clusterizator_Init_Geo_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Add a set of dots with geographic coordinates to the existing dots
+        using _Clusterizator_Append_Geo_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Add a set of timed dots of the sliding window
+        using _Clusterizator_Append_Timed_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Delete timed dots that left the sliding window
+        using _Clusterizator_Expire_Dots = int32_t (*)(const uint32_t ClusterizatorId, const int64_t Min_Time, uint32_t& Out_ExpiredCount);
+
+        // Load dots from the columnar point file (Append: 1 - add to the existing dots, 0 - replace all data), the number of points with NaN or infinite coordinates is returned in Out_RejectedCount
+        using _Clusterizator_Load_Point_File = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount);
+
+        // Load dots from the CSV file (columns are numbered from 0, Data_Column = -1 - no data; Append: 1 - add to the existing dots, 0 - replace all data)
+        using _Clusterizator_Load_CSV_File = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+
+        // Load point coordinates from the GeoJSON file, data of the dot is the number of its "coordinates" member (Append: 1 - add to the existing dots, 0 - replace all data)
+        using _Clusterizator_Load_GeoJSON_File = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+
         // Add single dot
         using _Clusterizator_Add_Dot = int32_t (*)(const uint32_t ClusterizatorId, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress);
 
+        // Select dots that take part in clustering by the bit mask of their indices
+        using _Clusterizator_Select_Dots = int32_t (*)(const uint32_t ClusterizatorId, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount);
+
+        // Select dots that take part in clustering by their tags
+        using _Clusterizator_Select_Dots_By_Tag = int32_t (*)(const uint32_t ClusterizatorId, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount);
+
         // Create set of clusters_1
         using _Clusterizator_Create_Clusters_1 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1);
 
@@ -65,6 +154,21 @@ namespace NS_Clustering
         // Create set of clusters_4
         using _Clusterizator_Create_Clusters_4 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4);
 
+        // Create set of clusters_1 approximately by the grid with cells of the size of the radius in linear time (Merge_Neighbors: 1 - merge clusters of neighboring cells once), error bounds are described at Create_Grid_Clusters_1 in SimpleClustering.h
+        using _Clusterizator_Create_Grid_Clusters_1 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_2 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+        using _Clusterizator_Create_Grid_Clusters_2 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_3 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+        using _Clusterizator_Create_Grid_Clusters_3 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_4 approximately by the grid (see Clusterizator_Create_Grid_Clusters_1)
+        using _Clusterizator_Create_Grid_Clusters_4 = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors);
+
+        // Create all sets of clusters progressively: the coarse preview of clusters_4 by the grid, then clusters_1 ... clusters_4 exactly, Callback is called after each set (SingleElem_Mask: bit N - 1 - single elements become clusters_N)
+        using _Clusterizator_Create_Clusters_Progressive = int32_t (*)(const uint32_t ClusterizatorId, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context);
+
 
         // Clear all sets of clusters
         using _Clusterizator_Clear_Clusters = int32_t (*)(const uint32_t ClusterizatorId);
@@ -73,12 +177,22 @@ namespace NS_Clustering
         using _Clusterizator_Clear = int32_t (*)(const uint32_t ClusterizatorId);
 
 
+        // Save clusterizator to the snapshot file
+        using _Clusterizator_Save_Snapshot = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName);
+
+        // Load clusterizator from the snapshot file, all current data is replaced
+        using _Clusterizator_Load_Snapshot = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName);
+
+
         // Get the number of clustering elements of the specified id
         using _Clusterizator_Get_ClusteringElem_Count = uint64_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId);
 
         // Get the amount of data for clustering element of the specified id
         using _Clusterizator_Get_ClusteringElem_Data_Count = uint64_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y);
 
+        // Get the amount of data for clustering element of the specified id by its index
+        using _Clusterizator_Get_ClusteringElem_Data_Count_By_Index = uint64_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index);
+
         // Get the amount of data for all clustering elements of the specified id
         using _Clusterizator_Get_All_ClusteringElem_Data_Count = uint64_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId);
 
@@ -89,18 +203,227 @@ namespace NS_Clustering
         // Get a set of specified clustering elements
         using _Clusterizator_Get_ClusteringElems = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr);
 
-        // Get data for all dots for specified clustering element
+        // Get indices of specified clustering elements (in the same order as Clusterizator_Get_ClusteringElems)
+        using _Clusterizator_Get_ClusteringElem_Indices = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, uint32_t* Index_Arr);
+
+        // Get clustering elements of all specified ids which are not in any cluster in one call (1 is returned if Out_Count is greater than Capacity, then arrays are filled up to Capacity)
+        using _Clusterizator_Get_Visible_ClusteringElems = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count);
+
+        // Get read-only arrays of clustering elements of the specified id without copying, the view is valid until the next change of dots or clusters
+        using _Clusterizator_Get_ClusteringElem_View = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, TClusteringElemView& Out_View);
+
+        // Get data for all dots for specified clustering element (the sorted union of their datasets)
         using _Clusterizator_Get_ClusteringElem_Data = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr);
 
+        // Get data for all dots for specified clustering element by its index
+        using _Clusterizator_Get_ClusteringElem_Data_By_Index = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr);
+
+        // Get a page of data for all dots for specified clustering element: no more than PageSize values of their datasets one after another starting from the position Cursor
+        using _Clusterizator_Get_ClusteringElem_Data_Page = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor);
+
+        // Get a page of data for all dots for specified clustering element by its index
+        using _Clusterizator_Get_ClusteringElem_Data_Page_By_Index = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor);
+
 
         // Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
         using _Clusterizator_Is_ClusteringElem_Have_Tag = int16_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag);
 
+        // Does the specified clustering element contain the specified tag by its index (1 - yes, 0 - no)
+        using _Clusterizator_Is_ClusteringElem_Have_Tag_By_Index = int16_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag);
+
         // Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
         using _Clusterizator_Is_ClusteringElem_Have_Tag_Inside = int16_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag);
 
+        // Does the specified clustering element contain the specified tag among all its clustering elements by its index (1 - yes, 0 - no)
+        using _Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index = int16_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag);
+
+        // Does each of the specified clustering elements contain the specified tag among all its clustering elements (Result_Arr: 1 - yes, 0 - no)
+        using _Clusterizator_Is_ClusteringElems_Have_Tag_Inside = int32_t (*)(const uint32_t ClusterizatorId, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr);
+
+        // Notify that tags were changed by the addresses of tags, so that the index of tags is rebuilt
+        using _Clusterizator_Tags_Changed = int32_t (*)(const uint32_t ClusterizatorId);
+
+        // Get instrumentation counters of the last creation of clusters_1..4 into Out_Stats_Arr of 4 elements (1 - the library is built without SIMPLE_CLUSTERING_STATS)
+        using _Clusterizator_Get_Stats = int32_t (*)(const uint32_t ClusterizatorId, TStats* Out_Stats_Arr);
+
+        // Start recording of the timeline of loading, clustering and exporting
+        using _Clusterizator_Start_Trace = int32_t (*)(const uint32_t ClusterizatorId);
+
+        // Stop recording of the timeline and write it to the file in Chrome Trace Event JSON format (FileName - nullptr: the timeline is discarded)
+        using _Clusterizator_Stop_Trace = int32_t (*)(const uint32_t ClusterizatorId, const char* FileName);
+
+        // Get the memory of the clusterizator in bytes: Out_Total_Bytes - all memory, Out_Usage_Arr - memory of dots and clusters_1..4 by structures (5 elements, nullptr - only the total is got)
+        using _Clusterizator_Get_Memory_Usage = int32_t (*)(const uint32_t ClusterizatorId, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes);
+
+        // Reclaim the memory of datasets of dots loaded by arrays
+        using _Clusterizator_Compact_Dot_Data = int32_t (*)(const uint32_t ClusterizatorId, uint64_t& Out_FreedBytes);
+
+
+        // Create a new clusterizator. Its handle is returned (nullptr - failure)
+        using _HClusterizator_New = HClusterizator (*)(void);
+
+        // Get the handle of the clusterizator by its id (nullptr - there is no such clusterizator)
+        using _HClusterizator_Find = HClusterizator (*)(const uint32_t ClusterizatorId);
+
+        // Get the id of the clusterizator by its handle (0 - invalid handle)
+        using _HClusterizator_Get_Id = uint32_t (*)(HClusterizator Handle);
+
+        // Delete clusterizator by its handle, the handle becomes invalid
+        using _HClusterizator_Delete = int32_t (*)(HClusterizator Handle);
+
+        // Initialize a set of dots
+        using _HClusterizator_Init_Dots = int32_t (*)(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Add a set of dots to the existing dots
+        using _HClusterizator_Append_Dots = int32_t (*)(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Initialize a set of dots with geographic coordinates, they are projected to Web Mercator once and the dots are clustered and returned in it
+        using _HClusterizator_Init_Geo_Dots = int32_t (*)(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Add a set of dots with geographic coordinates to the existing dots
+        using _HClusterizator_Append_Geo_Dots = int32_t (*)(HClusterizator Handle, const uint32_t ArrSize, const double* Lon_Arr, const double* Lat_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Add a set of timed dots of the sliding window
+        using _HClusterizator_Append_Timed_Dots = int32_t (*)(HClusterizator Handle, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const int64_t* Time_Arr, const uint64_t** Address_Of_Data_Arr);
+
+        // Delete timed dots that left the sliding window
+        using _HClusterizator_Expire_Dots = int32_t (*)(HClusterizator Handle, const int64_t Min_Time, uint32_t& Out_ExpiredCount);
+
+        // Load dots from the columnar point file (Append: 1 - add to the existing dots, 0 - replace all data), the number of points with NaN or infinite coordinates is returned in Out_RejectedCount
+        using _HClusterizator_Load_Point_File = int32_t (*)(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_RejectedCount);
+
+        // Load dots from the CSV file (columns are numbered from 0, Data_Column = -1 - no data; Append: 1 - add to the existing dots, 0 - replace all data)
+        using _HClusterizator_Load_CSV_File = int32_t (*)(HClusterizator Handle, const char* FileName, const char Delimiter, const uint32_t SkipLines, const int32_t X_Column, const int32_t Y_Column, const int32_t Data_Column, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+
+        // Load point coordinates from the GeoJSON file, data of the dot is the number of its "coordinates" member (Append: 1 - add to the existing dots, 0 - replace all data)
+        using _HClusterizator_Load_GeoJSON_File = int32_t (*)(HClusterizator Handle, const char* FileName, const int16_t Append, uint64_t& Out_PointCount, uint64_t& Out_RejectedCount);
+
+        // Add single dot
+        using _HClusterizator_Add_Dot = int32_t (*)(HClusterizator Handle, const double X, const double Y, const uint64_t* Address_Of_Data, uint64_t*& Out_DotTagAddress);
+
+        // Select dots that take part in clustering by the bit mask of their indices
+        using _HClusterizator_Select_Dots = int32_t (*)(HClusterizator Handle, const uint8_t* Mask_Arr, const uint32_t DotCount, uint32_t& Out_SelectedCount);
+
+        // Select dots that take part in clustering by their tags
+        using _HClusterizator_Select_Dots_By_Tag = int32_t (*)(HClusterizator Handle, const uint64_t Tag_Mask, const uint64_t Tag_Value, uint32_t& Out_SelectedCount);
+
+        // Create set of clusters_1
+        using _HClusterizator_Create_Clusters_1 = int32_t (*)(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1);
+
+        // Create set of clusters_2
+        using _HClusterizator_Create_Clusters_2 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2);
+
+        // Create set of clusters_3
+        using _HClusterizator_Create_Clusters_3 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3);
+
+        // Create set of clusters_4
+        using _HClusterizator_Create_Clusters_4 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4);
+
+        // Create set of clusters_1 approximately by the grid with cells of the size of the radius in linear time (Merge_Neighbors: 1 - merge clusters of neighboring cells once), error bounds are described at Create_Grid_Clusters_1 in SimpleClustering.h
+        using _HClusterizator_Create_Grid_Clusters_1 = int32_t (*)(HClusterizator Handle, const int16_t SingleDot_To_Cluster_1, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_2 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+        using _HClusterizator_Create_Grid_Clusters_2 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_2, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_3 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+        using _HClusterizator_Create_Grid_Clusters_3 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_3, const int16_t Merge_Neighbors);
+
+        // Create set of clusters_4 approximately by the grid (see HClusterizator_Create_Grid_Clusters_1)
+        using _HClusterizator_Create_Grid_Clusters_4 = int32_t (*)(HClusterizator Handle, const int16_t SingleClusteringElem_To_Cluster_4, const int16_t Merge_Neighbors);
+
+        // Create all sets of clusters progressively (see Clusterizator_Create_Clusters_Progressive)
+        using _HClusterizator_Create_Clusters_Progressive = int32_t (*)(HClusterizator Handle, const int16_t SingleElem_Mask, TLevelReadyCallback Callback, void* Context);
+
+        // Clear all sets of clusters
+        using _HClusterizator_Clear_Clusters = int32_t (*)(HClusterizator Handle);
+
+        // Clear clusterizator
+        using _HClusterizator_Clear = int32_t (*)(HClusterizator Handle);
+
+        // Save clusterizator to the snapshot file
+        using _HClusterizator_Save_Snapshot = int32_t (*)(HClusterizator Handle, const char* FileName);
+
+        // Load clusterizator from the snapshot file, all current data is replaced
+        using _HClusterizator_Load_Snapshot = int32_t (*)(HClusterizator Handle, const char* FileName);
+
+        // Get the number of clustering elements of the specified id
+        using _HClusterizator_Get_ClusteringElem_Count = uint64_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId);
+
+        // Get the amount of data for clustering element of the specified id
+        using _HClusterizator_Get_ClusteringElem_Data_Count = uint64_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y);
+
+        // Get the amount of data for clustering element of the specified id by its index
+        using _HClusterizator_Get_ClusteringElem_Data_Count_By_Index = uint64_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index);
+
+        // Get the amount of data for all clustering elements of the specified id
+        using _HClusterizator_Get_All_ClusteringElem_Data_Count = uint64_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId);
+
+        // Get the amount of data for all clustering elements of clusterizator
+        using _HClusterizator_Get_Data_Count = uint64_t (*)(HClusterizator Handle);
+
+        // Get a set of specified clustering elements
+        using _HClusterizator_Get_ClusteringElems = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, double* X_Arr, double* Y_Arr, int16_t** Address_Of_InCluster_Arr, uint64_t** Address_Of_DataCount_Arr, uint64_t** Address_Of_TagAddress_Arr);
+
+        // Get indices of specified clustering elements (in the same order as Clusterizator_Get_ClusteringElems)
+        using _HClusterizator_Get_ClusteringElem_Indices = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, uint32_t* Index_Arr);
+
+        // Get clustering elements of all specified ids which are not in any cluster in one call (1 is returned if Out_Count is greater than Capacity, then arrays are filled up to Capacity)
+        using _HClusterizator_Get_Visible_ClusteringElems = int32_t (*)(HClusterizator Handle, const uint16_t* ClusteringElemId_List, const uint32_t ClusteringElemId_List_Size, const uint64_t Capacity, uint16_t* ClusteringElemId_Arr, double* X_Arr, double* Y_Arr, uint64_t* DataCount_Arr, uint32_t* Index_Arr, uint64_t& Out_Count);
+
+        // Get read-only arrays of clustering elements of the specified id without copying, the view is valid until the next change of dots or clusters
+        using _HClusterizator_Get_ClusteringElem_View = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, TClusteringElemView& Out_View);
+
+        // Get data for all dots for specified clustering element (the sorted union of their datasets)
+        using _HClusterizator_Get_ClusteringElem_Data = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, uint64_t* Data_Arr);
+
+        // Get data for all dots for specified clustering element by its index
+        using _HClusterizator_Get_ClusteringElem_Data_By_Index = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, uint64_t* Data_Arr);
+
+        // Get a page of data for all dots for specified clustering element: no more than PageSize values starting from the position Cursor
+        using _HClusterizator_Get_ClusteringElem_Data_Page = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor);
+
+        // Get a page of data for all dots for specified clustering element by its index
+        using _HClusterizator_Get_ClusteringElem_Data_Page_By_Index = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Cursor, const uint64_t PageSize, uint64_t* Data_Arr, uint64_t& Out_Count, uint64_t& Out_NextCursor);
+
+        // Does the specified clustering element contain the specified tag (1 - yes, 0 - no)
+        using _HClusterizator_Is_ClusteringElem_Have_Tag = int16_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag);
+
+        // Does the specified clustering element contain the specified tag by its index (1 - yes, 0 - no)
+        using _HClusterizator_Is_ClusteringElem_Have_Tag_By_Index = int16_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag);
+
+        // Does the specified clustering element contain the specified tag among all its clustering elements (1 - yes, 0 - no)
+        using _HClusterizator_Is_ClusteringElem_Have_Tag_Inside = int16_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const double X, const double Y, const uint64_t Tag);
+
+        // Does the specified clustering element contain the specified tag among all its clustering elements by its index (1 - yes, 0 - no)
+        using _HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index = int16_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t Index, const uint64_t Tag);
+
+        // Does each of the specified clustering elements contain the specified tag among all its clustering elements (Result_Arr: 1 - yes, 0 - no)
+        using _HClusterizator_Is_ClusteringElems_Have_Tag_Inside = int32_t (*)(HClusterizator Handle, const uint16_t ClusteringElemId, const uint32_t ArrSize, const double* X_Arr, const double* Y_Arr, const uint64_t Tag, int16_t* Result_Arr);
+
+        // Notify that tags were changed by the addresses of tags, so that the index of tags is rebuilt
+        using _HClusterizator_Tags_Changed = int32_t (*)(HClusterizator Handle);
+
+        // Get instrumentation counters of the last creation of clusters_1..4 into Out_Stats_Arr of 4 elements (1 - the library is built without SIMPLE_CLUSTERING_STATS)
+        using _HClusterizator_Get_Stats = int32_t (*)(HClusterizator Handle, TStats* Out_Stats_Arr);
+
+        // Get the memory of the clusterizator in bytes: Out_Total_Bytes - all memory, Out_Usage_Arr - memory of dots and clusters_1..4 by structures (5 elements, nullptr - only the total is got)
+        using _HClusterizator_Get_Memory_Usage = int32_t (*)(HClusterizator Handle, TMemoryUsage* Out_Usage_Arr, uint64_t& Out_Total_Bytes);
+
+        // Reclaim the memory of datasets of dots loaded by arrays
+        using _HClusterizator_Compact_Dot_Data = int32_t (*)(HClusterizator Handle, uint64_t& Out_FreedBytes);
+
+        // Start recording of the timeline of loading, clustering and exporting
+        using _HClusterizator_Start_Trace = int32_t (*)(HClusterizator Handle);
+
+        // Stop recording of the timeline and write it to the file in Chrome Trace Event JSON format (FileName - nullptr: the timeline is discarded)
+        using _HClusterizator_Stop_Trace = int32_t (*)(HClusterizator Handle, const char* FileName);
+
     public:
-        HINSTANCE HandleDll; // id for DLL
+        #if defined(_WIN32)
+          HINSTANCE HandleDll; // id for DLL
+        #else
+          void* HandleDll; // handle of the shared object
+        #endif
 
         // Cluster object identifiers
         const uint16_t*  ID_DOT;
@@ -128,36 +451,133 @@ namespace NS_Clustering
         _ClusteringElems_Set_Default_AdditionalRadiusValue_Settings  ClusteringElems_Set_Default_AdditionalRadiusValue_Settings;
         _ClusteringElems_Set_AdditionalRadiusValue_Settings          ClusteringElems_Set_AdditionalRadiusValue_Settings;
 
+        _Coords_Geo_To_Web_Mercator  Coords_Geo_To_Web_Mercator;
+        _Coords_Web_Mercator_To_Geo  Coords_Web_Mercator_To_Geo;
+
         _Clusterizator_New         Clusterizator_New;
         _Clusterizator_Delete      Clusterizator_Delete;
         _Clusterizator_Delete_All  Clusterizator_Delete_All;
 
-        _Clusterizator_Init_Dots          Clusterizator_Init_Dots;
-        _Clusterizator_Add_Dot            Clusterizator_Add_Dot;
-        _Clusterizator_Create_Clusters_1  Clusterizator_Create_Clusters_1;
-        _Clusterizator_Create_Clusters_2  Clusterizator_Create_Clusters_2;
-        _Clusterizator_Create_Clusters_3  Clusterizator_Create_Clusters_3;
-        _Clusterizator_Create_Clusters_4  Clusterizator_Create_Clusters_4;
+        _Clusterizator_Init_Dots                    Clusterizator_Init_Dots;
+        _Clusterizator_Append_Dots                  Clusterizator_Append_Dots;
+        _Clusterizator_Init_Geo_Dots                Clusterizator_Init_Geo_Dots;
+        _Clusterizator_Append_Geo_Dots              Clusterizator_Append_Geo_Dots;
+        _Clusterizator_Append_Timed_Dots            Clusterizator_Append_Timed_Dots;
+        _Clusterizator_Expire_Dots                  Clusterizator_Expire_Dots;
+        _Clusterizator_Load_Point_File              Clusterizator_Load_Point_File;
+        _Clusterizator_Load_CSV_File                Clusterizator_Load_CSV_File;
+        _Clusterizator_Load_GeoJSON_File            Clusterizator_Load_GeoJSON_File;
+        _Clusterizator_Add_Dot                      Clusterizator_Add_Dot;
+        _Clusterizator_Select_Dots                  Clusterizator_Select_Dots;
+        _Clusterizator_Select_Dots_By_Tag           Clusterizator_Select_Dots_By_Tag;
+        _Clusterizator_Create_Clusters_1            Clusterizator_Create_Clusters_1;
+        _Clusterizator_Create_Clusters_2            Clusterizator_Create_Clusters_2;
+        _Clusterizator_Create_Clusters_3            Clusterizator_Create_Clusters_3;
+        _Clusterizator_Create_Clusters_4            Clusterizator_Create_Clusters_4;
+        _Clusterizator_Create_Grid_Clusters_1       Clusterizator_Create_Grid_Clusters_1;
+        _Clusterizator_Create_Grid_Clusters_2       Clusterizator_Create_Grid_Clusters_2;
+        _Clusterizator_Create_Grid_Clusters_3       Clusterizator_Create_Grid_Clusters_3;
+        _Clusterizator_Create_Grid_Clusters_4       Clusterizator_Create_Grid_Clusters_4;
+        _Clusterizator_Create_Clusters_Progressive  Clusterizator_Create_Clusters_Progressive;
 
         _Clusterizator_Clear_Clusters  Clusterizator_Clear_Clusters;
         _Clusterizator_Clear           Clusterizator_Clear;
 
-        _Clusterizator_Get_ClusteringElem_Count           Clusterizator_Get_ClusteringElem_Count;
-        _Clusterizator_Get_ClusteringElem_Data_Count      Clusterizator_Get_ClusteringElem_Data_Count;
-        _Clusterizator_Get_All_ClusteringElem_Data_Count  Clusterizator_Get_All_ClusteringElem_Data_Count;
-        _Clusterizator_Get_Data_Count                     Clusterizator_Get_Data_Count;
-
-        _Clusterizator_Get_ClusteringElems      Clusterizator_Get_ClusteringElems;
-        _Clusterizator_Get_ClusteringElem_Data  Clusterizator_Get_ClusteringElem_Data;
-
-        _Clusterizator_Is_ClusteringElem_Have_Tag         Clusterizator_Is_ClusteringElem_Have_Tag;
-        _Clusterizator_Is_ClusteringElem_Have_Tag_Inside  Clusterizator_Is_ClusteringElem_Have_Tag_Inside;
+        _Clusterizator_Save_Snapshot  Clusterizator_Save_Snapshot;
+        _Clusterizator_Load_Snapshot  Clusterizator_Load_Snapshot;
+
+        _Clusterizator_Get_ClusteringElem_Count                Clusterizator_Get_ClusteringElem_Count;
+        _Clusterizator_Get_ClusteringElem_Data_Count           Clusterizator_Get_ClusteringElem_Data_Count;
+        _Clusterizator_Get_ClusteringElem_Data_Count_By_Index  Clusterizator_Get_ClusteringElem_Data_Count_By_Index;
+        _Clusterizator_Get_All_ClusteringElem_Data_Count       Clusterizator_Get_All_ClusteringElem_Data_Count;
+        _Clusterizator_Get_Data_Count                          Clusterizator_Get_Data_Count;
+
+        _Clusterizator_Get_ClusteringElems                    Clusterizator_Get_ClusteringElems;
+        _Clusterizator_Get_ClusteringElem_Indices             Clusterizator_Get_ClusteringElem_Indices;
+        _Clusterizator_Get_Visible_ClusteringElems            Clusterizator_Get_Visible_ClusteringElems;
+        _Clusterizator_Get_ClusteringElem_View                Clusterizator_Get_ClusteringElem_View;
+        _Clusterizator_Get_ClusteringElem_Data                Clusterizator_Get_ClusteringElem_Data;
+        _Clusterizator_Get_ClusteringElem_Data_By_Index       Clusterizator_Get_ClusteringElem_Data_By_Index;
+        _Clusterizator_Get_ClusteringElem_Data_Page           Clusterizator_Get_ClusteringElem_Data_Page;
+        _Clusterizator_Get_ClusteringElem_Data_Page_By_Index  Clusterizator_Get_ClusteringElem_Data_Page_By_Index;
+
+        _Clusterizator_Is_ClusteringElem_Have_Tag                  Clusterizator_Is_ClusteringElem_Have_Tag;
+        _Clusterizator_Is_ClusteringElem_Have_Tag_By_Index         Clusterizator_Is_ClusteringElem_Have_Tag_By_Index;
+        _Clusterizator_Is_ClusteringElem_Have_Tag_Inside           Clusterizator_Is_ClusteringElem_Have_Tag_Inside;
+        _Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index  Clusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index;
+        _Clusterizator_Is_ClusteringElems_Have_Tag_Inside          Clusterizator_Is_ClusteringElems_Have_Tag_Inside;
+        _Clusterizator_Tags_Changed                                Clusterizator_Tags_Changed;
+        _Clusterizator_Get_Stats                                   Clusterizator_Get_Stats;
+        _Clusterizator_Start_Trace                                 Clusterizator_Start_Trace;
+        _Clusterizator_Stop_Trace                                  Clusterizator_Stop_Trace;
+        _Clusterizator_Get_Memory_Usage                            Clusterizator_Get_Memory_Usage;
+        _Clusterizator_Compact_Dot_Data                            Clusterizator_Compact_Dot_Data;
+
+        _HClusterizator_New                                         HClusterizator_New;
+        _HClusterizator_Find                                        HClusterizator_Find;
+        _HClusterizator_Get_Id                                      HClusterizator_Get_Id;
+        _HClusterizator_Delete                                      HClusterizator_Delete;
+        _HClusterizator_Init_Dots                                   HClusterizator_Init_Dots;
+        _HClusterizator_Append_Dots                                 HClusterizator_Append_Dots;
+        _HClusterizator_Init_Geo_Dots                               HClusterizator_Init_Geo_Dots;
+        _HClusterizator_Append_Geo_Dots                             HClusterizator_Append_Geo_Dots;
+        _HClusterizator_Append_Timed_Dots                           HClusterizator_Append_Timed_Dots;
+        _HClusterizator_Expire_Dots                                 HClusterizator_Expire_Dots;
+        _HClusterizator_Load_Point_File                             HClusterizator_Load_Point_File;
+        _HClusterizator_Load_CSV_File                               HClusterizator_Load_CSV_File;
+        _HClusterizator_Load_GeoJSON_File                           HClusterizator_Load_GeoJSON_File;
+        _HClusterizator_Add_Dot                                     HClusterizator_Add_Dot;
+        _HClusterizator_Select_Dots                                 HClusterizator_Select_Dots;
+        _HClusterizator_Select_Dots_By_Tag                          HClusterizator_Select_Dots_By_Tag;
+        _HClusterizator_Create_Clusters_1                           HClusterizator_Create_Clusters_1;
+        _HClusterizator_Create_Clusters_2                           HClusterizator_Create_Clusters_2;
+        _HClusterizator_Create_Clusters_3                           HClusterizator_Create_Clusters_3;
+        _HClusterizator_Create_Clusters_4                           HClusterizator_Create_Clusters_4;
+        _HClusterizator_Create_Grid_Clusters_1                      HClusterizator_Create_Grid_Clusters_1;
+        _HClusterizator_Create_Grid_Clusters_2                      HClusterizator_Create_Grid_Clusters_2;
+        _HClusterizator_Create_Grid_Clusters_3                      HClusterizator_Create_Grid_Clusters_3;
+        _HClusterizator_Create_Grid_Clusters_4                      HClusterizator_Create_Grid_Clusters_4;
+        _HClusterizator_Create_Clusters_Progressive                 HClusterizator_Create_Clusters_Progressive;
+        _HClusterizator_Clear_Clusters                              HClusterizator_Clear_Clusters;
+        _HClusterizator_Clear                                       HClusterizator_Clear;
+        _HClusterizator_Save_Snapshot                               HClusterizator_Save_Snapshot;
+        _HClusterizator_Load_Snapshot                               HClusterizator_Load_Snapshot;
+        _HClusterizator_Get_ClusteringElem_Count                    HClusterizator_Get_ClusteringElem_Count;
+        _HClusterizator_Get_ClusteringElem_Data_Count               HClusterizator_Get_ClusteringElem_Data_Count;
+        _HClusterizator_Get_ClusteringElem_Data_Count_By_Index      HClusterizator_Get_ClusteringElem_Data_Count_By_Index;
+        _HClusterizator_Get_All_ClusteringElem_Data_Count           HClusterizator_Get_All_ClusteringElem_Data_Count;
+        _HClusterizator_Get_Data_Count                              HClusterizator_Get_Data_Count;
+        _HClusterizator_Get_ClusteringElems                         HClusterizator_Get_ClusteringElems;
+        _HClusterizator_Get_ClusteringElem_Indices                  HClusterizator_Get_ClusteringElem_Indices;
+        _HClusterizator_Get_Visible_ClusteringElems                 HClusterizator_Get_Visible_ClusteringElems;
+        _HClusterizator_Get_ClusteringElem_View                     HClusterizator_Get_ClusteringElem_View;
+        _HClusterizator_Get_ClusteringElem_Data                     HClusterizator_Get_ClusteringElem_Data;
+        _HClusterizator_Get_ClusteringElem_Data_By_Index            HClusterizator_Get_ClusteringElem_Data_By_Index;
+        _HClusterizator_Get_ClusteringElem_Data_Page                HClusterizator_Get_ClusteringElem_Data_Page;
+        _HClusterizator_Get_ClusteringElem_Data_Page_By_Index       HClusterizator_Get_ClusteringElem_Data_Page_By_Index;
+        _HClusterizator_Is_ClusteringElem_Have_Tag                  HClusterizator_Is_ClusteringElem_Have_Tag;
+        _HClusterizator_Is_ClusteringElem_Have_Tag_By_Index         HClusterizator_Is_ClusteringElem_Have_Tag_By_Index;
+        _HClusterizator_Is_ClusteringElem_Have_Tag_Inside           HClusterizator_Is_ClusteringElem_Have_Tag_Inside;
+        _HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index  HClusterizator_Is_ClusteringElem_Have_Tag_Inside_By_Index;
+        _HClusterizator_Is_ClusteringElems_Have_Tag_Inside          HClusterizator_Is_ClusteringElems_Have_Tag_Inside;
+        _HClusterizator_Tags_Changed                                HClusterizator_Tags_Changed;
+        _HClusterizator_Get_Stats                                   HClusterizator_Get_Stats;
+        _HClusterizator_Get_Memory_Usage                            HClusterizator_Get_Memory_Usage;
+        _HClusterizator_Compact_Dot_Data                            HClusterizator_Compact_Dot_Data;
+        _HClusterizator_Start_Trace                                 HClusterizator_Start_Trace;
+        _HClusterizator_Stop_Trace                                  HClusterizator_Stop_Trace;
 
 
         ~TClustering(void) noexcept;
 
-        // Load DLL
-        bool LoadDll(const std::wstring& DllDir) noexcept;
+        // CoordType - type of coordinates of the library (SimpleClustering, SimpleClustering_Float or SimpleClustering_Int), its functions are the same
+        #if defined(_WIN32)
+          // Load DLL
+          bool LoadDll(const std::wstring& DllDir, const TCoordType CoordType = COORD_DOUBLE) noexcept;
+        #else
+          // Load the shared object "libSimpleClustering.so" from the directory (empty - the search path of the dynamic linker)
+          bool LoadDll(const std::string& DllDir, const TCoordType CoordType = COORD_DOUBLE) noexcept;
+        #endif
     };
 }
 